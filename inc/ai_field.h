@@ -0,0 +1,37 @@
+#ifndef _AI_FIELD_H_
+#define _AI_FIELD_H_
+
+#include "genesis.h"
+#include "ai_riders.h"
+
+// Peloton persistant : tous les concurrents de la course. Seuls les plus
+// proches du joueur sont simulés complètement (aiHot/aiRiders) ; les autres
+// avancent selon un modèle analytique (allure moyenne + incidents),
+// mis à jour quelques-uns par frame.
+#define AI_FIELD_SIZE         20          // Concurrents max dans la course
+#define AI_FIELD_MAX_ACTIVE   8           // Concurrents simulés complètement
+#define AI_FIELD_UPDATES      4           // Entrées analytiques mises à jour par frame
+
+typedef struct {
+    s32 worldZ;              // Position sur la piste (16.16)
+    s16 pace;                // Allure moyenne (unités de speed)
+    s16 laneX;               // Ligne préférée
+    AIHandle rider;          // Rider simulé, AI_NO_HANDLE sinon
+    u8 aiType;               // AIType
+    u8 incidentTimer;        // Frames restantes à l'arrêt (chute)
+    u8 lastUpdate;           // Frame de la dernière mise à jour analytique
+} AIFieldEntry;
+
+extern AIFieldEntry aiField[AI_FIELD_SIZE];
+extern u8 aiFieldCount;
+extern u8 aiFieldOrder[AI_FIELD_SIZE];   // Classement : worldZ décroissant
+
+void initAIField(void);
+u8 addFieldEntry(AIType type, s32 worldZ, s16 laneX);
+void updateAIField(void);
+void promoteFieldEntry(u8 entry);
+void demoteFieldRider(u8 id);
+void retireFieldEntry(u8 entry);
+u8 getFieldPosition(s32 worldZ);
+
+#endif // _AI_FIELD_H_
@@ -20,16 +20,23 @@ typedef struct {
 } AISaveState;
 
 // Configuration du spawning des IA
+#define AI_SPAWN_AHEAD 200          // Unités devant le joueur où apparaît le rider
+
 typedef struct {
-    u16 spawnDistance;      // Distance de spawn
+    u16 spawnDistance;      // Position de déclenchement (unités de piste, tables triées)
     AIType aiType;          // Type d'IA à spawner
     s16 laneX;             // Position X de spawn
     u8 probability;         // Probabilité de spawn (0-255)
+    u8 kind;                // EntityKind (ENTITY_RIDER, aiType ignoré sinon)
 } AISpawnPoint;
 
 // Variables globales (extern pour utilisation dans d'autres fichiers)
 extern u8 activeRiders;
+extern AIRiderHot aiHot;
 extern AIRider aiRiders[MAX_AI_RIDERS];
+extern u8 aiLive[MAX_AI_RIDERS];
+extern u8 aiOrder[MAX_AI_RIDERS];
+extern u8 aiOrderCount;
 extern s32 trackPosition;
 
 // Fonctions d'initialisation et configuration
@@ -39,25 +46,27 @@ void resetAISystem(void);
 
 // Fonctions de mise à jour principales
 void updateAISpawning(void);
+void armSegmentSpawns(u8 list, s32 segmentStart);
 void updateAIDifficulty(void);
-void updateFullAISystem(s16 roadCurve);
+void updateFullAISystem(void);
 
 // Gestion des interactions avec le joueur
 void handlePlayerAIInteraction(void);
-void handleCloseInteraction(AIRider* rider);
+void handleCloseInteraction(u8 id);
 void triggerCollisionEffects(s16 x, s16 y);
 
 // Optimisation et performance
 void optimizeAIPerformance(void);
 void cullDistantRiders(void);
-void adjustUpdateFrequency(void);
+void releaseDistantRider(u8 id);
 void boostActiveRiders(void);
 
 // Statistiques et debug
 void updateAIStatistics(void);
 void displayAIDebugInfo(void);
 u8 getActiveRiderCount(void);
-AIRider* getNearestRider(s16 playerX);
+AIHandle getNearestRider(s16 playerX);
+u8 getPlayerRacePosition(void);
 
 // Sauvegarde/chargement
 void saveAIState(AISaveState* state);
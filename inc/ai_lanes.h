@@ -0,0 +1,28 @@
+#ifndef _AI_LANES_H_
+#define _AI_LANES_H_
+
+#include "genesis.h"
+#include "ai_riders.h"
+
+// Occupation de la route autour du joueur, reconstruite à chaque frame :
+// un mot de 16 bits (un bit par couloir latéral) par tranche de Z.
+// "Le couloir de x est-il libre sur les N prochaines unités ?" se résout
+// par un OU de quelques mots et un test de bits, sans boucle sur les riders.
+#define AI_LANE_COUNT         16          // Couloirs (bits d'un mot)
+#define AI_LANE_SHIFT         4           // Largeur d'un couloir : 16 px
+#define AI_LANE_ORIGIN        32          // x du bord gauche du couloir 0
+#define AI_LANE_BUCKETS       32          // Tranches de Z
+#define AI_LANE_BUCKET_SHIFT  20          // Tranche de 16 unités (worldZ 16.16)
+#define AI_LANE_BEHIND        (64L << 16) // Début de la fenêtre derrière le joueur
+#define AI_LANE_HALF_WIDTH    (AI_COLLIDE_X / 2) // Demi-largeur d'un rider
+#define AI_LANE_NONE          (-1)        // findFreeLane : aucun couloir libre
+
+extern u16 aiLaneMap[AI_LANE_BUCKETS];   // Bit n : couloir n occupé
+extern s32 aiLaneBaseZ;                  // worldZ du début de la tranche 0
+
+void buildLaneMap(void);
+void markLaneObstacle(s32 worldZ, s16 x, s16 halfWidth);
+bool isLaneFree(s16 x, s32 worldZ, u16 distance);
+s16 findFreeLane(s16 x, s32 worldZ, u16 distance);
+
+#endif // _AI_LANES_H_
@@ -0,0 +1,49 @@
+#ifndef _AI_LAYOUT_H_
+#define _AI_LAYOUT_H_
+
+/*
+ * ai_layout.h - Disposition mémoire de l'IA partagée entre C et assembleur
+ *
+ * Inclus par ai_riders.h et par les .s (passés par cpp). Uniquement des
+ * #define et des commentaires C : pas de typedef ni de commentaires //.
+ * ai_riders.c vérifie à la compilation que ces offsets correspondent à
+ * AIRiderHot.
+ */
+
+#define MAX_AI_RIDERS 32
+#define MAX_ENTITIES  MAX_AI_RIDERS  /* Riders, trafic, obstacles : mêmes emplacements */
+
+/* Drapeaux par emplacement (aiHot.flags) */
+#define AI_FLAG_ACTIVE      0x01    /* Simulation active */
+#define AI_FLAG_VISIBLE     0x02    /* Visible (culling) */
+#define AI_FLAG_ACTIVE_BIT  0
+#define AI_FLAG_VISIBLE_BIT 1
+
+/* Composants d'une entité (entity.h), fixés au spawn selon son type */
+#define ENT_FLAG_AI         0x04    /* Bloc IA (décisions, combat, peloton) */
+#define ENT_FLAG_COLLIDER   0x08    /* Participe aux collisions */
+#define ENT_FLAG_MOTION     0x10    /* Intégré par la physique */
+#define ENT_FLAG_SOLID      0x20    /* Occupe son couloir (ai_lanes.c) */
+#define ENT_FLAG_AI_BIT       2
+#define ENT_FLAG_COLLIDER_BIT 3
+#define ENT_FLAG_MOTION_BIT   4
+#define ENT_FLAG_SOLID_BIT    5
+
+/* Boîte de collision : écart latéral (px) et en Z (16.16, sans suffixe L pour gas) */
+#define AI_COLLIDE_X        18
+#define AI_COLLIDE_Z        (18 << 16)
+
+/* Offsets des tableaux de AIRiderHot (octets) */
+#define AIHOT_WORLDZ        0
+#define AIHOT_X             (AIHOT_WORLDZ + 4 * MAX_AI_RIDERS)
+#define AIHOT_Y             (AIHOT_X + 2 * MAX_AI_RIDERS)
+#define AIHOT_SPEED         (AIHOT_Y + 2 * MAX_AI_RIDERS)
+#define AIHOT_TARGETX       (AIHOT_SPEED + 2 * MAX_AI_RIDERS)
+#define AIHOT_MAXSPEED      (AIHOT_TARGETX + 2 * MAX_AI_RIDERS)
+#define AIHOT_ACCELERATION  (AIHOT_MAXSPEED + 2 * MAX_AI_RIDERS)
+#define AIHOT_HANDLING      (AIHOT_ACCELERATION + 2 * MAX_AI_RIDERS)
+#define AIHOT_FLAGS         (AIHOT_HANDLING + 2 * MAX_AI_RIDERS)
+#define AIHOT_LODDT         (AIHOT_FLAGS + MAX_AI_RIDERS)
+#define AIHOT_SIZE          ((AIHOT_LODDT + MAX_AI_RIDERS + 1) & ~1)
+
+#endif /* _AI_LAYOUT_H_ */
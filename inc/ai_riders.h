@@ -2,9 +2,21 @@
 #define _AI_RIDERS_H_
 
 #include "genesis.h"
+#include "ai_layout.h"
 
-// Constantes
-#define MAX_AI_RIDERS 8
+// Constantes (MAX_AI_RIDERS et offsets partagés dans ai_layout.h)
+#define AI_NO_RIDER   0xFF       // Index invalide (aucun rider)
+#define AI_DECISION_SLOTS 32     // Emplacements du tour de décisions (puissance de 2)
+#define AI_URGENT_QUEUE_SIZE 8   // Décisions urgentes en attente
+#define AI_URGENT_PER_FRAME  2   // Décisions urgentes traitées par frame
+#define AI_NEAR_Z_WINDOW (32L << 16) // Fenêtre Z "à côté du joueur" (16.16)
+#define AI_MAX_CONTACTS  32       // Paires en contact traitées par frame
+#define AI_CONTACT_PLAYER 0xFE    // Second membre d'une paire : le joueur
+#define AI_NO_HANDLE  0xFFFF     // Handle invalide
+
+// Référence durable à un rider : génération de l'emplacement (octet haut) et
+// index (octet bas). Périmé dès que le rider est libéré (resolveRiderHandle).
+typedef u16 AIHandle;
 
 // Types d'IA
 typedef enum {
@@ -12,7 +24,11 @@ typedef enum {
     AI_DEFENSIVE,         // Collision avoidance, cautious driving
     AI_ERRATIC,          // Unpredictable behavior patterns
     AI_RUBBER_BAND,      // Speed adjustment based on player position
-    AI_BLOCKER          // Actively blocks player progress
+    AI_BLOCKER,         // Actively blocks player progress
+    AI_VETERAN,         // Clean racing line, rarely attacks
+    AI_ROOKIE,          // Hesitant lines, weak and inaccurate attacks
+    AI_BRAWLER,         // Combat-focused, sacrifices speed for fights
+    AI_TYPE_COUNT
 } AIType;
 
 // États de l'IA
@@ -21,84 +37,212 @@ typedef enum {
     AI_STATE_ATTACKING,      // Active player attack
     AI_STATE_AVOIDING,       // Obstacle/collision avoidance
     AI_STATE_CRASHED,        // Post-crash recovery
-    AI_STATE_CATCHING_UP     // Rubber-band catch-up mode
+    AI_STATE_CATCHING_UP,    // Rubber-band catch-up mode
+    AI_STATE_COUNT
 } AIState;
 
-// Structure du rider IA
+// Priorité d'une décision urgente (la plus haute est servie d'abord)
+typedef enum {
+    AI_URGENT_NONE = 0,
+    AI_URGENT_COLLISION,     // Contact avec un autre rider
+    AI_URGENT_HIT            // Touché par le joueur
+} AIUrgency;
+
+// Réaction à un joueur très proche (handleCloseInteraction)
+typedef enum {
+    AI_CLOSE_NONE = 0,
+    AI_CLOSE_INTIMIDATE,     // Ralentit le joueur
+    AI_CLOSE_BLOCK,          // Se place devant lui
+    AI_CLOSE_AVOID           // S'écarte (AI_STATE_AVOIDING)
+} AICloseAction;
+
+// Paramètres de comportement d'un type d'IA (ROM, ai_behavior.c)
+typedef struct {
+    // Pilotage
+    s16 maxSpeed;
+    s16 acceleration;
+    s16 handling;
+    s16 rubberBandStrength;
+    u16 aggression;          // Niveau initial (augmenté par la difficulté)
+
+    // Course
+    s16 lineOffset;          // Décalage par rapport à la trajectoire idéale (px)
+    u16 lookAhead;           // Couloir vérifié sur ces unités (0 = ne regarde pas)
+    s16 laneSpread;          // Écart autour de la trajectoire (±px)
+    u16 sightDistance;       // Distance latérale de poursuite
+    u16 chaseAggression;     // Agressivité minimale pour poursuivre
+    s16 aimSpread;           // Dispersion de la visée sur le joueur (±px)
+    u8 wanderChance;         // % de changement de ligne par décision
+    s16 wanderMin;           // Ligne d'errance dans [wanderMin, +wanderRange[
+    u16 wanderRange;
+    s16 avoidDistance;       // Écartement préventif sous cette distance
+    s16 avoidOffset;         // Décalage d'écartement
+    s16 panicDistance;       // Passage en évitement sous cette distance
+    u16 avoidDuration;       // Frames en évitement
+
+    // Attaque
+    u16 attackRange;         // Engagement sous cette distance
+    u8 attackChance;         // % d'engagement par décision
+    u16 attackDuration;      // Frames en attaque
+    s16 attackSpeedBonus;    // Vitesse au-dessus de max en attaque
+    u16 strikeRange;         // Distance de frappe
+    s16 hitRange;            // Seuil de collision du coup
+    u8 hitChance;            // % de coups portés
+    s16 hitDamage;           // Vitesse retirée au joueur
+    u16 attackCooldown;      // Après la fin d'une attaque
+    u16 hitCooldown;         // Après un coup (+ aléa de 60 frames)
+
+    // États communs
+    s16 swerve;              // Écart en évitement
+    s16 catchUpBonus;        // Vitesse au-dessus de max en rattrapage
+    s16 crashHeal;           // Santé rendue après un crash
+    u8 incidentChance;       // Chute hors écran, /256 par mise à jour (ai_field.c)
+
+    // Interaction rapprochée
+    u8 closeAction;          // AICloseAction
+    s16 closeRange;
+} AIParams;
+
+// Gestionnaire de décision d'un (type, état)
+typedef void (*AIHandler)(u8 id);
+
+// Données chaudes : lues chaque frame par la physique, le culling, les
+// collisions et le rendu. Tableaux parallèles indexés par rider, contigus
+// par champ pour des boucles serrées et un adressage (An,Dn.w) en assembleur.
+// Toute modification doit être reportée dans ai_layout.h (AIHOT_*).
+typedef struct {
+    s32 worldZ[MAX_AI_RIDERS];       // Position sur la piste (16.16)
+    s16 x[MAX_AI_RIDERS];            // Position latérale écran
+    s16 y[MAX_AI_RIDERS];            // Position verticale écran
+    s16 speed[MAX_AI_RIDERS];        // Vitesse actuelle
+    s16 targetX[MAX_AI_RIDERS];      // Cible latérale choisie par l'IA
+    s16 maxSpeed[MAX_AI_RIDERS];     // Vitesse max (personnalité + difficulté)
+    s16 acceleration[MAX_AI_RIDERS]; // Taux d'accélération
+    s16 handling[MAX_AI_RIDERS];     // Maniabilité (0-255)
+    u8 flags[MAX_AI_RIDERS];         // AI_FLAG_*
+    u8 lodDt[MAX_AI_RIDERS];         // Frames à intégrer cette frame (0 = ignoré)
+} AIRiderHot;
+
+// Données froides : personnalité, machine à états, animation et combat,
+// consultées seulement lors des décisions ou des interactions
 typedef struct {
-    // Physics and position (fixed-point 16.16 for precision)
-    s16 x, y;                // Screen coordinates
-    s32 worldX, worldZ;      // World position (16.16 fixed-point)
-    s16 speed;               // Current speed
-    s16 maxSpeed;            // Maximum speed capability
-    s16 acceleration;        // Acceleration rate
-    s16 handling;            // Steering responsiveness (0-255)
-    
     // AI behavior parameters
-    AIType aiType;           // Personality type
-    AIState state;           // Current state
+    u8 aiType;               // Personality type (AIType)
+    u8 state;                // Current state (AIState)
     u16 stateTimer;          // State duration counter
-    s16 targetX;             // Target X position
-    s16 decisionTimer;       // Decision-making interval
-    
+    u8 decisionSlot;         // Slot in the decision round (one decision per lap)
+
     // Adaptive difficulty
     s16 rubberBandStrength;  // Rubber-band effect strength
     s16 playerDistance;      // Distance to player
     u16 aggressionLevel;     // Aggression intensity (0-255)
-    
-    // Rendering and animation
-    u8 spriteIndex;          // Assigned sprite slot
-    u8 animFrame;            // Current animation frame
-    u8 animTimer;            // Animation timing
-    bool visible;            // Visibility culling flag
-    bool active;             // Simulation active flag
-    
+
     // Combat system
     u16 attackTimer;         // Attack cooldown
     s16 health;              // Damage points
     bool canAttack;          // Attack capability flag
+
+    // Rendering and animation
+    u8 spriteIndex;          // Assigned sprite slot
+    u8 frameSlot;            // VRAM frame region (rider_frames.h)
+    u8 animFrame;            // Current animation frame
+    u8 animTimer;            // Animation timing
+    s16 screenX;             // Projected on the road strips (renderAIRiders)
+    u16 screenScale;         // Strip scale (8.8), 0 when off screen
+
+    // Level of detail
+    u8 lodShift;             // Update period = 1 << lodShift frames
+    u8 lodLastFrame;         // Frame of last update (aiLodFrame)
+
+    // Entity
+    u8 kind;                 // EntityKind (entity.h)
+
+    // Race field
+    u8 fieldIndex;           // aiField entry, AI_NO_RIDER if not a field member
+
+    // Pool
+    u8 generation;           // Incremented on release (stale handle check)
+    u8 poolLink;             // Live: index in aiLive ; free: next free slot
+    u8 orderIndex;           // Index in aiOrder (kept by updateRiderOrder)
 } AIRider;
 
+// Paire en contact produite par la détection de collisions
+typedef struct {
+    u8 a;                    // Entité (index)
+    u8 b;                    // Entité (index) ou AI_CONTACT_PLAYER
+} AIContact;
+
 // Variables globales
+extern const AIParams aiParams[AI_TYPE_COUNT];
+extern const AIHandler aiHandlers[AI_TYPE_COUNT][AI_STATE_COUNT];
+extern AIRiderHot aiHot;
 extern AIRider aiRiders[MAX_AI_RIDERS];
 extern u8 activeRiders;
+extern u8 aiLive[MAX_AI_RIDERS];   // Riders vivants (ordre quelconque)
+extern u8 aiOrder[MAX_AI_RIDERS];  // Riders actifs triés par worldZ décroissant
+extern u8 aiOrderCount;
+extern bool aiOrderDirty;          // Retrait depuis le dernier tri
+extern AIContact aiContacts[AI_MAX_CONTACTS];
+extern u8 aiContactCount;
+extern u8 aiLodUpdates;
+extern u8 aiDecisionCount;
 extern s32 trackPosition;
 extern s16 playerX;
 extern s16 playerSpeed;
 
 // Fonctions publiques
-void updateAIPhysicsASM(AIRider* rider, s16 targetX, s16 roadCurve);
+void updateAIPhysicsBatchASM(AIRiderHot* hot, const u8* live, u16 count,
+                             const u8* speedProfile, u16 profileLength);
+u16 sweepAICollisionsASM(const AIRiderHot* hot, const u8* order, u16 count,
+                         AIContact* contacts, u16 maxContacts);
 bool checkCollisionASM(s16 x1, s16 y1, s16 x2, s16 y2, s16 threshold);
-void sortRidersByDistance(AIRider* riders, u16 count);
 
 // Fonctions d'intégration IA
 void initAISystem(void);
-void spawnAIRider(AIType aiType, s32 worldZ, s16 laneX);
-void disableAIRider(AIRider* rider);
-void updateAISystem(s16 roadCurve);
-void handlePlayerAICollision(AIRider* rider);
+u8 allocEntity(u8 kind, s32 worldZ, s16 x);
+u8 spawnAIRider(AIType aiType, s32 worldZ, s16 laneX);
+void disableAIRider(u8 id);
+void updateAISystem(void);
+void handlePlayerAICollision(u8 id);
 void spawnInitialRiders(void);
 void boostActiveRiders(void);
-void handleCloseInteraction(AIRider* rider);
+void handleCloseInteraction(u8 id);
 void triggerCollisionEffects(s16 x, s16 y);
 void cullDistantRiders(void);
-void adjustUpdateFrequency(void);
 void updateAIStatistics(void);
 u8 getActiveRiderCount(void);
-AIRider* getNearestRider(s16 x);
+AIHandle getNearestRider(s16 x);
+AIHandle getRiderHandle(u8 id);
+u8 resolveRiderHandle(AIHandle handle);
+u8 getPlayerRacePosition(void);
 
 // Fonctions internes AI
-void updateRacingAI(AIRider* rider);
-void updateAttackingAI(AIRider* rider);
-void updateAvoidingAI(AIRider* rider);
-void updateCrashedAI(AIRider* rider);
-void updateCatchingUpAI(AIRider* rider);
-void updateRubberBandAI(AIRider* rider);
-void performAIAttack(AIRider* rider);
-void handleAICollision(AIRider* rider1, AIRider* rider2);
-void assignSpriteToAI(AIRider* rider);
-void releaseSpriteFromAI(AIRider* rider);
-void updateAIAnimation(AIRider* rider);
-u8 findFreeSprite(void);
+void initAIDecisions(void);
+void assignDecisionSlot(u8 id);
+void releaseDecisionSlot(u8 id);
+void requestUrgentDecision(u8 id, AIUrgency urgency);
+u8 scheduleAIDecisions(void);
+void updateAIDecisions(u8 id);
+void updateChaseAI(u8 id);
+void updateEvadeAI(u8 id);
+void updateWanderAI(u8 id);
+void updateBlockAI(u8 id);
+void updateAttackingAI(u8 id);
+void updateAvoidingAI(u8 id);
+void updateCrashedAI(u8 id);
+void updateCatchingUpAI(u8 id);
+void updateRubberBandAI(u8 id);
+void performAIAttack(u8 id);
+void checkAICollisions(void);
+void handleAICollision(u8 id1, u8 id2);
+void updateAIPhysics(void);
+void updateAIVisibility(void);
+void renderAIRiders(void);
+void assignSpriteToAI(u8 id);
+void releaseSpriteFromAI(u8 id);
+void updateAIAnimation(u8 id);
+void updateRiderOrder(void);
+u8 scheduleAILOD(void);
+u8 findOrderIndexForZ(s32 worldZ);
 
 #endif // _AI_RIDERS_H_
@@ -0,0 +1,48 @@
+#ifndef _DMA_QUEUE_H_
+#define _DMA_QUEUE_H_
+
+#include "genesis.h"
+
+// File de DMA unique pour tous les transferts de la frame (SAT, frames de
+// riders, tuiles, CRAM, VSRAM). Les producteurs y déposent leurs jobs avec
+// une priorité ; le callback de vblank les envoie dans l'ordre des
+// priorités tant que le budget d'octets du vblank le permet. Le reste est
+// reporté au vblank suivant (en tête de file, ordre conservé), découpé
+// quand il s'agit d'un transfert de fond.
+#define DMA_QUEUE_JOBS       32      // Jobs en attente au plus
+
+// Débit DMA vers la VRAM pendant le blanking en H40 : ~205 octets par ligne.
+// Lignes hors affichage : 262 - 224 en NTSC, 313 - 224 en PAL, moins une
+// marge pour l'entrée de l'interruption et le traitement de SGDK
+#define DMA_BYTES_PER_LINE   205
+#define DMA_MARGIN_LINES     4
+#define DMA_BUDGET_NTSC      ((262 - 224 - DMA_MARGIN_LINES) * DMA_BYTES_PER_LINE)
+#define DMA_BUDGET_PAL       ((313 - 224 - DMA_MARGIN_LINES) * DMA_BYTES_PER_LINE)
+#define DMA_SPLIT_MIN        256     // Reste de budget en dessous duquel on ne découpe plus
+
+typedef enum {
+    DMA_PRIORITY_HIGH = 0,   // Jamais reporté (SAT, palettes) : compte dans le budget
+    DMA_PRIORITY_NORMAL,     // Envoyé entier ou reporté (frames de riders)
+    DMA_PRIORITY_LOW,        // Transferts de fond, découpés au budget restant
+    DMA_PRIORITIES
+} DMAPriority;
+
+typedef struct {
+    u16 bytesSent;           // Au dernier vblank
+    u16 bytesDeferred;       // Restés en file après le dernier vblank
+    u32 totalSent;
+    u16 framesOverBudget;    // Vblanks qui ont laissé des jobs en file
+    u16 jobsDropped;         // Refusés, file pleine
+} DMAQueueStats;
+
+extern DMAQueueStats dmaStats;
+
+void initDMAQueue(void);
+// length en mots, to en octets. busy (facultatif) passe à 1 à l'ajout et
+// revient à 0 quand le job est entièrement parti : la source doit rester
+// intacte jusque-là. Retourne FALSE si la file est pleine.
+bool queueDMAJob(DMAType type, const void* from, u16 to, u16 length, u8 priority, volatile u8* busy);
+void flushDMAQueue(void);
+u16 getDMABudget(void);
+
+#endif // _DMA_QUEUE_H_
@@ -0,0 +1,41 @@
+#ifndef _ENTITY_H_
+#define _ENTITY_H_
+
+#include "genesis.h"
+#include "ai_riders.h"
+
+// Entités de la route : riders, trafic, obstacles et bonus partagent les
+// emplacements du pool IA (MAX_ENTITIES). Transform et mouvement dans aiHot,
+// sprite et bloc IA dans aiRiders ; les composants présents sont des bits de
+// aiHot.flags (ENT_FLAG_*) que chaque système teste dans sa passe existante.
+// Un nouveau type ne demande qu'une ligne dans entityKinds, aucune boucle.
+// Les riders ont leurs frames par zones (rider_frames.h) ; les autres types
+// lisent les leurs dans la banque des objets de route (scenery.h).
+typedef enum {
+    ENTITY_RIDER = 0,        // Concurrent IA (spawnAIRider)
+    ENTITY_TRAFFIC,          // Voiture à vitesse de croisière, ligne fixe
+    ENTITY_OIL_SLICK,        // Flaque immobile : dérapage
+    ENTITY_PICKUP,           // Bonus immobile : santé, ramassé au contact
+    ENTITY_KIND_COUNT
+} EntityKind;
+
+#define ENTITY_RIDER_FRAMES  0xFF
+
+// Contact d'une entité sans IA avec un rider ou le joueur (AI_CONTACT_PLAYER)
+typedef void (*EntityContactHandler)(u8 id, u8 other);
+
+// Description d'un type d'entité (ROM, entity.c)
+typedef struct {
+    u8 components;               // ENT_FLAG_* posés au spawn
+    s16 cruiseSpeed;             // Vitesse max (0 = immobile)
+    s16 acceleration;
+    EntityContactHandler onContact;  // NULL pour les riders (ai_riders.c)
+    u8 frames;                   // SceneryType, ENTITY_RIDER_FRAMES pour les riders
+} EntityKindInfo;
+
+extern const EntityKindInfo entityKinds[ENTITY_KIND_COUNT];
+
+u8 spawnEntity(EntityKind kind, s32 worldZ, s16 x);
+void resolveEntityContact(u8 a, u8 b);
+
+#endif // _ENTITY_H_
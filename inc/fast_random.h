@@ -0,0 +1,41 @@
+#ifndef _FAST_RANDOM_H_
+#define _FAST_RANDOM_H_
+
+/*
+ * fast_random.h - Générateur pseudo-aléatoire xorshift32 (fast_random.s)
+ *
+ * Un flux indépendant par sous-système : une même graine donne la même
+ * suite de tirages, quel que soit l'ordre d'appel des autres sous-systèmes
+ * (replays, benchmarks). Aucune division : les intervalles sont obtenus par
+ * multiplication haute (mulu.w puis swap).
+ *
+ * Inclus aussi par fast_random.s : la partie C est protégée par __ASSEMBLER__.
+ */
+
+/* Flux */
+#define RANDOM_STREAM_AI      0     /* Décisions des riders */
+#define RANDOM_STREAM_SPAWN   1     /* Apparitions et placement */
+#define RANDOM_STREAM_EFFECTS 2     /* Effets visuels et sonores */
+#define RANDOM_STREAM_COUNT   3
+
+#define RANDOM_RACE_SEED      0x2F6B1D35  /* Graine par défaut d'une course */
+
+#ifndef __ASSEMBLER__
+
+#include "genesis.h"
+
+void seedRandomStreams(u32 seed);
+u16 fastRandomASM(u16 stream);
+u16 randomRangeASM(u16 stream, u16 range);
+
+// Tirage dans [-halfRange, halfRange[
+#define randomSpread(stream, halfRange) \
+    ((s16)randomRangeASM(stream, (halfRange) * 2) - (s16)(halfRange))
+
+// Vrai avec une probabilité de percent %
+#define randomChance(stream, percent) \
+    (randomRangeASM(stream, 100) < (percent))
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* _FAST_RANDOM_H_ */
@@ -0,0 +1,27 @@
+#ifndef _HUD_H_
+#define _HUD_H_
+
+#include "genesis.h"
+
+// HUD sur le plan fenêtre, en haut de l'écran. Le cadre (libellés) est
+// écrit une fois ; chaque frame, updateHUD compare les valeurs à celles
+// affichées et ne réécrit que les cellules des champs qui ont changé.
+// Les chiffres passent par une table de paires 00-99 (une division par
+// 100 pour deux chiffres, pas de sprintf). Rien ne change : rien n'est
+// envoyé.
+#define HUD_ROWS             3       // Lignes de cellules couvertes par la fenêtre
+#define HUD_COLUMNS          40
+
+typedef struct {
+    u16 score;
+    s16 speed;
+    u16 health;              // 0-100
+    u8 position;             // Place en course
+    u8 riders;               // Concurrents, joueur compris
+    u8 level;                // Affiché tel quel (1 = premier)
+} HUDValues;
+
+void initHUD(void);
+void updateHUD(const HUDValues* values);
+
+#endif // _HUD_H_
@@ -0,0 +1,32 @@
+#ifndef _PALETTES_H_
+#define _PALETTES_H_
+
+#include "genesis.h"
+
+// Gestionnaire de palettes : une copie de travail des 4 palettes en RAM
+// (image de la CRAM) et des couleurs de repos. Flashs, fondus vers une
+// couleur et fondus enchaînés sont des jobs avancés d'un pas par frame
+// dans updatePalettes ; seules les plages modifiées de chaque ligne de
+// palette partent en CRAM, par la file de DMA, au vblank. Un nouveau job
+// remplace ceux qui touchent les mêmes couleurs.
+#define PALETTE_COLORS       64      // 4 lignes de 16 couleurs
+#define PALETTE_LINE_COLORS  16
+#define PALETTE_JOBS         4       // Effets simultanés au plus
+
+void initPaletteManager(void);
+void setPaletteColors(u16 first, const u16* colors, u16 count);
+u16 getPaletteColor(u16 index);
+
+// Couleur unie pendant frames, puis retour aux couleurs de repos
+bool flashPalette(u16 first, u16 count, u16 color, u8 frames);
+// Fondu vers une couleur unie, qui reste affichée
+bool fadePalette(u16 first, u16 count, u16 color, u8 frames);
+// Fondu vers une couleur puis retour aux couleurs de repos (transitions)
+bool dipPalette(u16 first, u16 count, u16 color, u8 frames);
+// Nouvelles couleurs de repos, atteintes par fondu enchaîné
+bool crossFadePalette(u16 first, const u16* colors, u16 count, u8 frames);
+bool isPaletteBusy(void);
+
+void updatePalettes(void);
+
+#endif // _PALETTES_H_
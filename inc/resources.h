@@ -6,5 +6,17 @@ extern const Image road_tiles;
 extern const Image grass_tiles;
 extern const Image sky_tiles;
 extern const Palette simple_palette;
+extern const TileSet bike0_zoom0;
+extern const TileSet bike0_zoom1;
+extern const TileSet bike0_zoom2;
+extern const TileSet bike0_zoom3;
+extern const TileSet bike1_zoom0;
+extern const TileSet bike1_zoom1;
+extern const TileSet bike1_zoom2;
+extern const TileSet bike1_zoom3;
+extern const TileSet scenery_zoom0;
+extern const TileSet scenery_zoom1;
+extern const TileSet scenery_zoom2;
+extern const TileSet scenery_zoom3;
 
 #endif // _RES_RESOURCES_H_
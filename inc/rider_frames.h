@@ -0,0 +1,40 @@
+#ifndef _RIDER_FRAMES_H_
+#define _RIDER_FRAMES_H_
+
+#include "genesis.h"
+#include "vram_layout.h"
+
+// Frames de rider pré-zoomées (tools/generate_zoom_frames.py) : chaque rider
+// affiché possède une zone VRAM fixe de la taille de la plus grande frame,
+// où sa frame courante est recopiée par DMA seulement quand la frame ou le
+// niveau de zoom change. La VRAM consommée ne dépend que du nombre de zones,
+// pas du nombre de modèles ni de frames.
+#define RIDER_DESIGNS        2       // Modèles de moto (bike<n>_zoom<z>)
+#define RIDER_ZOOM_LEVELS    4       // 32, 24, 16 et 8 pixels de côté
+#define RIDER_ANIM_FRAMES    4       // Frames d'animation par zoom
+#define RIDER_FRAME_SLOTS    VRAM_RIDER_FRAME_SLOTS  // Riders affichés simultanément
+#define RIDER_SLOT_TILES     VRAM_RIDER_SLOT_TILES   // Plus grande frame : 4x4 tuiles
+#define RIDER_FRAME_NONE     0xFF
+
+// Zones de frames, consécutives à partir de cette tuile (vram_layout.h)
+#define RIDER_FRAME_TILE     VRAM_RIDER_FRAME_TILE
+
+// Réduction logicielle des riders proches (sprite_scaler.c) : zoom au pas
+// de 2 pixels au lieu des 4 niveaux pré-calculés, à 0 pour s'en passer
+#ifndef RIDER_SOFT_SCALE
+#define RIDER_SOFT_SCALE     1
+#endif
+#define RIDER_SOFT_MIN_SCALE 96      // Réduction logicielle dès cette échelle (8.8)
+#define RIDER_SCALES_PER_FRAME 2     // Réductions au plus par frame
+
+void initRiderFrames(void);
+void beginRiderFrames(void);
+u8 allocRiderFrameSlot(void);
+void freeRiderFrameSlot(u8 slot);
+u8 getRiderZoom(u16 scale);
+u8 updateRiderFrame(u8 slot, u8 design, u16 scale, u8 frame);
+
+// Première tuile de la zone d'un slot
+#define RIDER_SLOT_TILE(slot) (RIDER_FRAME_TILE + (slot) * RIDER_SLOT_TILES)
+
+#endif // _RIDER_FRAMES_H_
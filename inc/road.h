@@ -0,0 +1,32 @@
+#ifndef _ROAD_H_
+#define _ROAD_H_
+
+#include "genesis.h"
+
+// Géométrie de l'écran et de la route
+#define MAX_STRIPS 120
+#define SCREEN_HEIGHT 224
+#define ROAD_BASE_WIDTH 160
+#define ROAD_CENTER_X 160
+#define HORIZON_Y 80
+#define PLAYER_SCREEN_Y 190      // Ligne du joueur (profondeur 0)
+
+// Profondeur des lignes : 1/16 d'unité de piste, relative au joueur
+#define ROAD_DEPTH_SHIFT 4
+#define ROAD_CAMERA_DEPTH 8192   // Profondeur caméra de la ligne d'horizon (512 unités)
+
+typedef struct {
+    u16 screenY;
+    u16 roadWidth;
+    s16 roadXOffset;
+    u16 scale;
+} RoadStrip;
+
+// Strips de la frame (rendus par renderRoadStripsASM) et profondeur de
+// chacun, de l'horizon (loin) vers le bas de l'écran (proche) : les objets
+// triés par Z s'y projettent en un seul parcours conjoint
+extern RoadStrip roadStrips[MAX_STRIPS];
+extern s16 roadStripDepth[MAX_STRIPS];
+extern u16 roadStripCount;
+
+#endif // _ROAD_H_
@@ -0,0 +1,49 @@
+#ifndef _SCENERY_H_
+#define _SCENERY_H_
+
+#include "genesis.h"
+
+// Objets de bord de route (arbres, panneaux, poteaux). Chaque niveau a un
+// flux d'objets trié par position ; seuls ceux qui entrent dans la
+// distance d'affichage sont tirés dans un petit anneau, projetés sur les
+// strips de la route comme les riders, dessinés par le gestionnaire de
+// sprites au zoom pré-calculé de leur échelle, puis retirés une fois
+// dépassés. Le coût dépend des objets visibles, pas de la longueur de la
+// piste. La même banque porte les frames des entités de la route autres
+// que les riders (entity.c), placées par renderAIRiders.
+#define SCENERY_TYPES        6
+#define SCENERY_RING         12      // Objets suivis au plus
+#define SCENERY_DRAW_DISTANCE 500    // Unités devant le joueur (horizon : ~507)
+#define SCENERY_MAX_SPRITES  8       // Objets dessinés au plus par frame
+#define SCENERY_PER_LINE     4       // Objets au plus sur une même ligne
+#define SCENERY_MIN_SCALE    24      // Plus petit : pas dessiné (8.8)
+#define SCENERY_END          0xFFFF  // position de l'entrée terminale du flux
+
+// Ordre des objets de tools/generate_scenery_frames.py
+typedef enum {
+    SCENERY_TREE = 0,
+    SCENERY_SIGN,
+    SCENERY_POST,
+    SCENERY_CAR,             // Entités de la route, hors flux de décor
+    SCENERY_OIL,
+    SCENERY_PICKUP
+} SceneryType;
+
+#define SCENERY_LEFT         (-1)
+#define SCENERY_RIGHT        1
+
+typedef struct {
+    u16 position;            // Unités de piste depuis le départ, croissantes
+    s8 side;                 // SCENERY_LEFT ou SCENERY_RIGHT
+    u8 type;                 // SceneryType
+} SceneryObject;
+
+extern u8 sceneryDrawn;      // Objets dessinés à la dernière frame
+
+void initScenery(const SceneryObject* stream);
+void resetScenery(void);
+void updateScenery(s32 trackPosition);
+// Première tuile VRAM de l'objet type au zoom de scale ; *tiles : côté en tuiles
+u16 getSceneryFrame(u8 type, u16 scale, u8* tiles);
+
+#endif // _SCENERY_H_
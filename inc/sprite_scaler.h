@@ -0,0 +1,23 @@
+#ifndef _SPRITE_SCALER_H_
+#define _SPRITE_SCALER_H_
+
+#include "genesis.h"
+
+// Réduction logicielle d'une frame 4bpp de 32x32 (16 tuiles, ordre des
+// sprites VDP) vers une taille quelconque de 8 à 32 pixels par pas de 2.
+// Les tables de saut (pixel source de chaque ligne/colonne de sortie) sont
+// calculées une fois ; la sortie est au format tuile, prête pour le DMA,
+// alignée en haut à gauche de sa boîte de tuiles (le reste transparent).
+#define SCALER_SOURCE_SIZE   32      // Côté de la frame source (pixels)
+#define SCALER_SOURCE_TILES  4
+#define SCALER_MIN_SIZE      8
+#define SCALER_BUCKETS       13      // Tailles 8, 10, ... 32
+#define SCALER_FRAME_LONGS   (SCALER_SOURCE_TILES * SCALER_SOURCE_TILES * 8)
+
+#define SCALER_BUCKET_SIZE(bucket) (SCALER_MIN_SIZE + ((bucket) << 1))
+
+void initSpriteScaler(void);
+u8 getScalerBucket(u16 scale);
+void scaleSpriteFrame(const u32* source, u32* dest, u8 bucket);
+
+#endif // _SPRITE_SCALER_H_
@@ -0,0 +1,38 @@
+#ifndef _SPRITES_H_
+#define _SPRITES_H_
+
+#include "genesis.h"
+
+// Gestionnaire de sprites matériels (remplace le moteur SPR de SGDK, dont
+// l'initialisation corrompait la VRAM). Les emplacements sont alloués par
+// les systèmes, positionnés chaque frame, puis buildSpriteTable reconstruit
+// la table d'attributs (SAT) en RAM : chaînage trié en profondeur, limite
+// de sprites par ligne respectée par rotation. La SAT part en un seul DMA
+// de priorité haute par la file de DMA (dma_queue.h).
+#define SPRITE_SLOTS       64      // Emplacements allouables
+#define SPRITE_NONE        0xFF    // Aucun emplacement
+#define SAT_ENTRIES        80      // Entrées de la SAT en H40
+#define SPRITES_PER_LINE   20      // Limite matérielle par ligne en H40
+
+// Un sprite matériel tel que le voient les systèmes de jeu
+typedef struct {
+    s16 x;                   // Coin haut gauche (pixels écran)
+    s16 y;
+    u16 attr;                // TILE_ATTR_FULL
+    u8 size;                 // SPRITE_SIZE(largeur, hauteur) en tuiles
+    u8 visible;
+    u16 depth;               // Distance à la caméra : 0 = devant tout
+    u8 next;                 // Liste libre
+} SpriteSlot;
+
+extern SpriteSlot spriteSlots[SPRITE_SLOTS];
+extern u8 spriteDeferred;    // Sprites repoussés en fin de chaînage cette frame
+
+void initSpriteManager(void);
+u8 allocSpriteSlot(void);
+void freeSpriteSlot(u8 slot);
+void placeSpriteSlot(u8 slot, s16 x, s16 y, u16 attr, u8 size, u16 depth);
+void hideSpriteSlot(u8 slot);
+void buildSpriteTable(void);
+
+#endif // _SPRITES_H_
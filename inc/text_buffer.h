@@ -0,0 +1,31 @@
+#ifndef _TEXT_BUFFER_H_
+#define _TEXT_BUFFER_H_
+
+#include "genesis.h"
+
+// Tampon de texte et de petites écritures de tilemap : le jeu écrit dans
+// une image en RAM de la zone de texte du plan B (entrées de tilemap), et
+// flushTextBuffer envoie une fois par frame, par la file de DMA, les suites
+// de cellules modifiées de chaque ligne. Le plan B n'est pas redessiné par
+// la route (plan A, lignes sous l'horizon) et ne défile pas : le texte y
+// reste. Les tuiles de texte ont la priorité haute, au-dessus de la route.
+// Le plan B se voit sous les cellules vides du HUD (fenêtre, lignes 0 à
+// HUD_ROWS - 1) : pas de texte sur ces lignes.
+// Une cellule réécrite avec la même valeur ne coûte rien ; plusieurs
+// écritures sur une cellule n'en envoient qu'une. Les messages temporisés
+// s'effacent seuls.
+#define TEXT_COLUMNS         40      // Écran H40
+#define TEXT_ROWS            28
+#define TEXT_JOBS_PER_FLUSH  8       // Suites mises en file au plus par frame
+#define TEXT_TIMED_MESSAGES  8       // Messages temporisés simultanés
+
+void initTextBuffer(void);
+void drawBufferedText(const char* text, u8 x, u8 y);
+void clearBufferedText(u8 x, u8 y, u8 length);
+void setBufferedTile(u8 x, u8 y, u16 tile);
+// Texte effacé après frames ; un message au même endroit relance le délai
+void drawTimedText(const char* text, u8 x, u8 y, u16 frames);
+
+void flushTextBuffer(void);
+
+#endif // _TEXT_BUFFER_H_
@@ -0,0 +1,53 @@
+#ifndef _TRACK_H_
+#define _TRACK_H_
+
+/*
+ * track.h - Segments de piste et trajectoire idéale précalculée
+ *
+ * La trajectoire (ligne latérale + profil de vitesse) est calculée une
+ * fois par niveau à partir des courbes des segments, puis seulement lue :
+ * une entrée par RACING_LINE_STEP unités de piste.
+ *
+ * Inclus aussi par ai_physics.s : la partie C est protégée par __ASSEMBLER__.
+ */
+
+#define TRACK_END_LENGTH      0xFFFF  /* length du segment terminal */
+
+/* eventFlags : liste de spawns du segment (segmentSpawnLists, ai_integration.c) */
+#define TRACK_EVENT_SPAWNS    0x01
+#define TRACK_EVENT_LIST(flags) ((flags) >> 4)  /* Index de la liste */
+
+#define RACING_LINE_SHIFT     2       /* Une entrée toutes les 4 unités */
+#define RACING_LINE_STEP      (1 << RACING_LINE_SHIFT)
+#define RACING_LINE_SIZE      256     /* Entrées max (1024 unités de piste) */
+
+/* Vitesse conseillée en fraction de maxSpeed : RACING_SPEED_ONE = pleine vitesse */
+#define RACING_SPEED_SHIFT    7
+#define RACING_SPEED_ONE      (1 << RACING_SPEED_SHIFT)
+
+#ifndef __ASSEMBLER__
+
+#include "genesis.h"
+
+typedef struct {
+    s16 curve;
+    s16 hill;
+    u16 length;
+    u8 decorType;
+    u8 roadType;
+    u8 paletteIndex;
+    u8 eventFlags;
+} TrackSegment;
+
+// Trajectoire idéale, indexée par getRacingLineIndex(worldZ)
+extern s8 racingLineX[RACING_LINE_SIZE];      // Décalage latéral depuis le centre
+extern u8 racingLineSpeed[RACING_LINE_SIZE];  // Vitesse conseillée (/RACING_SPEED_ONE)
+extern u16 racingLineLength;                  // Entrées valides (>= 1)
+extern u8 racingLineAverage;                  // Moyenne de racingLineSpeed sur le tour
+
+void buildRacingLine(const TrackSegment* track);
+u16 getRacingLineIndex(s32 worldZ);
+
+#endif /* __ASSEMBLER__ */
+
+#endif /* _TRACK_H_ */
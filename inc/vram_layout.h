@@ -0,0 +1,92 @@
+#ifndef _VRAM_LAYOUT_H_
+#define _VRAM_LAYOUT_H_
+
+/*
+ * vram_layout.h - Carte de la VRAM (64 Ko) partagée entre C et assembleur
+ *
+ * Seule description de l'occupation de la VRAM : banques de tuiles, plans,
+ * table des sprites, table de H-scroll et zones de frames des riders.
+ * Inclus par les .c et les .s (passés par cpp) : uniquement des #define et
+ * des commentaires C. Les vérifications en fin de fichier arrêtent la
+ * compilation si deux zones se chevauchent ou si la carte déborde.
+ *
+ * Les tables sont programmées au démarrage avec ces adresses
+ * (applyVRAMLayout, main.c), plutôt que de dépendre des valeurs par
+ * défaut de VDP_init.
+ */
+
+#define VRAM_SIZE            0x10000
+#define VRAM_TILE_BYTES      32
+
+/* Banques de tuiles (index de tuile) */
+#define VRAM_SYSTEM_TILE     0              /* Tuiles système SGDK */
+#define VRAM_SYSTEM_TILES    16
+#define VRAM_USER_TILE       (VRAM_SYSTEM_TILE + VRAM_SYSTEM_TILES)  /* TILE_USER_INDEX */
+
+#define VRAM_ROAD_TILE       VRAM_USER_TILE /* road_tiles : image 128x32 */
+#define VRAM_ROAD_TILES      64
+#define VRAM_GRASS_TILE      (VRAM_ROAD_TILE + VRAM_ROAD_TILES)
+#define VRAM_GRASS_TILES     64
+#define VRAM_SKY_TILE        (VRAM_GRASS_TILE + VRAM_GRASS_TILES)
+#define VRAM_SKY_TILES       64
+
+/* Zones de frames des riders (rider_frames.h) : une par rider affiché */
+#define VRAM_RIDER_FRAME_TILE   (VRAM_SKY_TILE + VRAM_SKY_TILES)
+#define VRAM_RIDER_FRAME_SLOTS  16
+#define VRAM_RIDER_SLOT_TILES   16          /* Plus grande frame : 4x4 tuiles */
+#define VRAM_RIDER_FRAME_TILES  (VRAM_RIDER_FRAME_SLOTS * VRAM_RIDER_SLOT_TILES)
+
+/* Objets de bord de route et entités (scenery.h) : tous les types et zooms,
+   chargés une fois par niveau ; 6 types de 16 + 9 + 4 + 1 tuiles */
+#define VRAM_SCENERY_TILE    (VRAM_RIDER_FRAME_TILE + VRAM_RIDER_FRAME_TILES)
+#define VRAM_SCENERY_TILES   180
+
+/* Police SGDK (font_default, rechargée par applyVRAMLayout) : 96 tuiles
+   juste sous la fenêtre */
+#define VRAM_FONT_TILES      96
+#define VRAM_FONT_TILE       (VRAM_WINDOW / VRAM_TILE_BYTES - VRAM_FONT_TILES)
+
+/* Tables du VDP (adresses octets), plans de 64x32 cellules */
+#define VRAM_PLANE_BYTES     (64 * 32 * 2)
+#define VRAM_WINDOW          0xB000
+#define VRAM_PLANE_A         0xC000
+#define VRAM_PLANE_B         0xE000
+#define VRAM_HSCROLL         0xF000         /* Un long par ligne : A puis B */
+#define VRAM_HSCROLL_BYTES   (224 * 4)
+#define VRAM_SPRITE_TABLE    0xF800         /* 80 entrées de 8 octets (H40) */
+#define VRAM_SPRITE_BYTES    (80 * 8)
+
+/* Fins de zones en octets, dans l'ordre des adresses */
+#define VRAM_TILES_END(tile, count) (((tile) + (count)) * VRAM_TILE_BYTES)
+
+#if VRAM_TILES_END(VRAM_SCENERY_TILE, VRAM_SCENERY_TILES) > VRAM_FONT_TILE * VRAM_TILE_BYTES
+#error "vram_layout.h : les banques de tuiles débordent sur la police"
+#endif
+#if VRAM_TILES_END(VRAM_FONT_TILE, VRAM_FONT_TILES) > VRAM_WINDOW
+#error "vram_layout.h : la police chevauche la fenêtre"
+#endif
+#if VRAM_WINDOW + VRAM_PLANE_BYTES > VRAM_PLANE_A
+#error "vram_layout.h : la fenêtre chevauche le plan A"
+#endif
+#if VRAM_PLANE_A + VRAM_PLANE_BYTES > VRAM_PLANE_B
+#error "vram_layout.h : le plan A chevauche le plan B"
+#endif
+#if VRAM_PLANE_B + VRAM_PLANE_BYTES > VRAM_HSCROLL
+#error "vram_layout.h : le plan B chevauche la table de H-scroll"
+#endif
+#if VRAM_HSCROLL + VRAM_HSCROLL_BYTES > VRAM_SPRITE_TABLE
+#error "vram_layout.h : la table de H-scroll chevauche la table des sprites"
+#endif
+#if VRAM_SPRITE_TABLE + VRAM_SPRITE_BYTES > VRAM_SIZE
+#error "vram_layout.h : la table des sprites déborde de la VRAM"
+#endif
+
+/* Alignements imposés par les registres du VDP */
+#if (VRAM_PLANE_A & 0x1FFF) || (VRAM_PLANE_B & 0x1FFF) || (VRAM_WINDOW & 0x0FFF)
+#error "vram_layout.h : plans mal alignés (A, B : 8 Ko ; fenêtre : 4 Ko en H40)"
+#endif
+#if (VRAM_SPRITE_TABLE & 0x03FF) || (VRAM_HSCROLL & 0x03FF)
+#error "vram_layout.h : tables mal alignées (sprites et H-scroll : 1 Ko)"
+#endif
+
+#endif /* _VRAM_LAYOUT_H_ */
@@ -14,6 +14,24 @@ IMAGE sky_tiles "res/sky_simple.png"
 # Sprite temporairement désactivé pour éviter conflit VRAM
 # SPRITE sprite_ai_bike "res/player_bike_sprite_(32x32).png" 2 2 FAST 0
 
+# Frames de rider pré-zoomées (tools/generate_zoom_frames.py) : non compressées
+# et sans optimisation, la frame f commence à la tuile f * (côté * côté)
+TILESET bike0_zoom0 "res/bike0_zoom0.png" NONE NONE
+TILESET bike0_zoom1 "res/bike0_zoom1.png" NONE NONE
+TILESET bike0_zoom2 "res/bike0_zoom2.png" NONE NONE
+TILESET bike0_zoom3 "res/bike0_zoom3.png" NONE NONE
+TILESET bike1_zoom0 "res/bike1_zoom0.png" NONE NONE
+TILESET bike1_zoom1 "res/bike1_zoom1.png" NONE NONE
+TILESET bike1_zoom2 "res/bike1_zoom2.png" NONE NONE
+TILESET bike1_zoom3 "res/bike1_zoom3.png" NONE NONE
+
+# Objets de bord de route pré-zoomés (tools/generate_scenery_frames.py), même
+# format : le type t commence à la tuile t * (côté * côté)
+TILESET scenery_zoom0 "res/scenery_zoom0.png" NONE NONE
+TILESET scenery_zoom1 "res/scenery_zoom1.png" NONE NONE
+TILESET scenery_zoom2 "res/scenery_zoom2.png" NONE NONE
+TILESET scenery_zoom3 "res/scenery_zoom3.png" NONE NONE
+
 # Palettes
 PALETTE simple_palette "res/simple_palette.png"
 
@@ -0,0 +1,452 @@
+/* ai_behavior.c - Moteur de comportement de l'IA piloté par tables */
+
+#include <genesis.h>
+#include "ai_riders.h"
+#include "fast_random.h"
+#include "track.h"
+#include "ai_lanes.h"
+
+#define RUBBER_BAND_DISTANCE 400   // Distance max rubber band
+#define ROAD_TARGET_MIN 80         // Cible latérale bornée à la route
+#define ROAD_TARGET_MAX 240
+#define ROAD_CENTER 160
+#define AVOID_LOOKAHEAD 64         // Unités vérifiées avant un écart d'évitement
+#define DECISION_SLOT_STRIDE 13    // Pas impair : nouveaux riders étalés sur le tour
+
+_Static_assert(MAX_AI_RIDERS <= AI_DECISION_SLOTS, "un slot de décision par rider");
+_Static_assert((AI_DECISION_SLOTS & (AI_DECISION_SLOTS - 1)) == 0, "AI_DECISION_SLOTS : puissance de 2");
+
+// === PARAMETRES PAR TYPE ===
+
+// Tous les seuils et probabilités du comportement, une ligne par type.
+// Une nouvelle personnalité = une ligne ici + une ligne dans aiHandlers.
+const AIParams aiParams[AI_TYPE_COUNT] = {
+    [AI_AGGRESSIVE] = {
+        .maxSpeed = 240, .acceleration = 4, .handling = 180,
+        .rubberBandStrength = 50, .aggression = 200,
+        .lookAhead = 64,
+        .laneSpread = 40, .sightDistance = 200, .chaseAggression = 150, .aimSpread = 20,
+        .attackRange = 32, .attackChance = 100, .attackDuration = 60, .attackSpeedBonus = 10,
+        .strikeRange = 32, .hitRange = 24, .hitChance = 100, .hitDamage = 15,
+        .attackCooldown = 180, .hitCooldown = 120,
+        .swerve = 80, .catchUpBonus = 30, .crashHeal = 20, .incidentChance = 1,
+        .closeAction = AI_CLOSE_INTIMIDATE, .closeRange = 20
+    },
+    [AI_DEFENSIVE] = {
+        .maxSpeed = 200, .acceleration = 3, .handling = 220,
+        .rubberBandStrength = 80, .aggression = 80,
+        .lineOffset = 20, .lookAhead = 128,
+        .avoidDistance = 80, .avoidOffset = 60, .panicDistance = 40, .avoidDuration = 90,
+        .strikeRange = 32, .hitRange = 20, .hitChance = 100, .hitDamage = 5,
+        .attackCooldown = 180, .hitCooldown = 120,
+        .swerve = 80, .catchUpBonus = 30, .crashHeal = 20, .incidentChance = 1,
+        .closeAction = AI_CLOSE_AVOID, .closeRange = 25
+    },
+    [AI_ERRATIC] = {
+        .maxSpeed = 220, .acceleration = 5, .handling = 140,
+        .rubberBandStrength = 30, .aggression = 150,
+        .wanderChance = 30, .wanderMin = 100, .wanderRange = 120,
+        .attackRange = 60, .attackChance = 25, .attackDuration = 30, .attackSpeedBonus = 10,
+        .strikeRange = 32, .hitRange = 28, .hitChance = 70, .hitDamage = 10,
+        .attackCooldown = 180, .hitCooldown = 120,
+        .swerve = 80, .catchUpBonus = 30, .crashHeal = 20, .incidentChance = 2,
+        .closeAction = AI_CLOSE_NONE
+    },
+    [AI_RUBBER_BAND] = {
+        .maxSpeed = 210, .acceleration = 3, .handling = 200,
+        .rubberBandStrength = 180, .aggression = 100,
+        .lookAhead = 64,
+        .laneSpread = 30,
+        .strikeRange = 32, .hitRange = 20, .hitChance = 100, .hitDamage = 5,
+        .attackCooldown = 180, .hitCooldown = 120,
+        .swerve = 80, .catchUpBonus = 30, .crashHeal = 20, .incidentChance = 1,
+        .closeAction = AI_CLOSE_NONE
+    },
+    [AI_BLOCKER] = {
+        .maxSpeed = 180, .acceleration = 2, .handling = 160,
+        .rubberBandStrength = 60, .aggression = 250,
+        .lookAhead = 96,
+        .aimSpread = 10,
+        .strikeRange = 32, .hitRange = 24, .hitChance = 100, .hitDamage = 15,
+        .attackCooldown = 180, .hitCooldown = 120,
+        .swerve = 80, .catchUpBonus = 30, .crashHeal = 20, .incidentChance = 1,
+        .closeAction = AI_CLOSE_BLOCK, .closeRange = 30
+    },
+    [AI_VETERAN] = {
+        // Trajectoire propre au centre, n'attaque que si on lui colle à la roue
+        .maxSpeed = 235, .acceleration = 4, .handling = 240,
+        .rubberBandStrength = 40, .aggression = 120,
+        .lookAhead = 128,
+        .laneSpread = 8, .sightDistance = 200, .chaseAggression = 150, .aimSpread = 10,
+        .attackRange = 24, .attackChance = 50, .attackDuration = 45, .attackSpeedBonus = 8,
+        .strikeRange = 28, .hitRange = 22, .hitChance = 90, .hitDamage = 12,
+        .attackCooldown = 150, .hitCooldown = 100,
+        .swerve = 60, .catchUpBonus = 20, .crashHeal = 30, .incidentChance = 0,
+        .closeAction = AI_CLOSE_NONE
+    },
+    [AI_ROOKIE] = {
+        // Hésitant : change souvent de ligne, attaque rarement et rate
+        .maxSpeed = 190, .acceleration = 3, .handling = 120,
+        .rubberBandStrength = 100, .aggression = 60,
+        .lineOffset = 24,
+        .wanderChance = 15, .wanderMin = 120, .wanderRange = 80,
+        .attackRange = 40, .attackChance = 10, .attackDuration = 30, .attackSpeedBonus = 5,
+        .strikeRange = 32, .hitRange = 30, .hitChance = 50, .hitDamage = 5,
+        .attackCooldown = 240, .hitCooldown = 150,
+        .swerve = 100, .catchUpBonus = 30, .crashHeal = 10, .incidentChance = 3,
+        .closeAction = AI_CLOSE_AVOID, .closeRange = 30
+    },
+    [AI_BRAWLER] = {
+        // Sacrifie la vitesse pour le combat : vise de loin, frappe fort
+        .maxSpeed = 200, .acceleration = 3, .handling = 170,
+        .rubberBandStrength = 60, .aggression = 255,
+        .lookAhead = 48,
+        .lineOffset = -12, .laneSpread = 40, .sightDistance = 240, .chaseAggression = 100, .aimSpread = 8,
+        .attackRange = 48, .attackChance = 100, .attackDuration = 90, .attackSpeedBonus = 10,
+        .strikeRange = 40, .hitRange = 28, .hitChance = 100, .hitDamage = 20,
+        .attackCooldown = 120, .hitCooldown = 90,
+        .swerve = 80, .catchUpBonus = 30, .crashHeal = 20, .incidentChance = 2,
+        .closeAction = AI_CLOSE_INTIMIDATE, .closeRange = 24
+    }
+};
+
+// === TABLE DES GESTIONNAIRES ===
+
+// Gestionnaire de décision par (type, état), en ROM
+const AIHandler aiHandlers[AI_TYPE_COUNT][AI_STATE_COUNT] = {
+    //                RACING               ATTACKING          AVOIDING           CRASHED           CATCHING_UP
+    [AI_AGGRESSIVE]  = { updateChaseAI,      updateAttackingAI, updateAvoidingAI, updateCrashedAI, updateCatchingUpAI },
+    [AI_DEFENSIVE]   = { updateEvadeAI,      updateAttackingAI, updateAvoidingAI, updateCrashedAI, updateCatchingUpAI },
+    [AI_ERRATIC]     = { updateWanderAI,     updateAttackingAI, updateAvoidingAI, updateCrashedAI, updateCatchingUpAI },
+    [AI_RUBBER_BAND] = { updateRubberBandAI, updateAttackingAI, updateAvoidingAI, updateCrashedAI, updateCatchingUpAI },
+    [AI_BLOCKER]     = { updateBlockAI,      updateAttackingAI, updateAvoidingAI, updateCrashedAI, updateCatchingUpAI },
+    [AI_VETERAN]     = { updateChaseAI,      updateAttackingAI, updateAvoidingAI, updateCrashedAI, updateCatchingUpAI },
+    [AI_ROOKIE]      = { updateWanderAI,     updateAttackingAI, updateAvoidingAI, updateCrashedAI, updateCatchingUpAI },
+    [AI_BRAWLER]     = { updateChaseAI,      updateAttackingAI, updateAvoidingAI, updateCrashedAI, updateCatchingUpAI }
+};
+
+// === ORDONNANCEMENT DES DECISIONS ===
+
+// Tour de décisions : chaque rider possède un slot fixe et décide quand le
+// tour y passe, une décision par frame au plus. S'y ajoutent au plus
+// AI_URGENT_PER_FRAME décisions urgentes (collision, coup reçu), prises dans
+// une petite file à priorités. Le coût IA d'une frame est ainsi borné.
+static u8 aiDecisionSlots[AI_DECISION_SLOTS];  // Rider par slot, AI_NO_RIDER si libre
+static u8 aiDecisionFrame = 0;
+static u8 aiSlotCursor = 0;
+
+// File urgente non triée : au plus AI_URGENT_QUEUE_SIZE entrées, parcourue
+// linéairement. Les handles écartent les riders libérés entre-temps.
+static AIHandle aiUrgentRider[AI_URGENT_QUEUE_SIZE];
+static u8 aiUrgentLevel[AI_URGENT_QUEUE_SIZE];
+static u8 aiUrgentCount = 0;
+
+void initAIDecisions(void) {
+    u8 i;
+    
+    for (i = 0; i < AI_DECISION_SLOTS; i++) {
+        aiDecisionSlots[i] = AI_NO_RIDER;
+    }
+    
+    aiDecisionFrame = 0;
+    aiSlotCursor = 0;
+    aiUrgentCount = 0;
+}
+
+void assignDecisionSlot(u8 id) {
+    u8 slot = aiSlotCursor;
+    
+    // Premier slot libre à partir du curseur (il en reste toujours un)
+    while (aiDecisionSlots[slot] != AI_NO_RIDER) {
+        slot = (slot + 1) & (AI_DECISION_SLOTS - 1);
+    }
+    
+    aiDecisionSlots[slot] = id;
+    aiRiders[id].decisionSlot = slot;
+    aiSlotCursor = (slot + DECISION_SLOT_STRIDE) & (AI_DECISION_SLOTS - 1);
+}
+
+void releaseDecisionSlot(u8 id) {
+    aiDecisionSlots[aiRiders[id].decisionSlot] = AI_NO_RIDER;
+}
+
+void requestUrgentDecision(u8 id, AIUrgency urgency) {
+    AIHandle handle = getRiderHandle(id);
+    u8 n, lowest = 0;
+    
+    // Déjà en attente : garde la priorité la plus haute
+    for (n = 0; n < aiUrgentCount; n++) {
+        if (aiUrgentRider[n] == handle) {
+            if (aiUrgentLevel[n] < urgency) aiUrgentLevel[n] = urgency;
+            return;
+        }
+        if (aiUrgentLevel[n] < aiUrgentLevel[lowest]) lowest = n;
+    }
+    
+    // File pleine : remplace la moins prioritaire si elle l'est moins
+    if (aiUrgentCount < AI_URGENT_QUEUE_SIZE) {
+        n = aiUrgentCount++;
+    } else if (aiUrgentLevel[lowest] < urgency) {
+        n = lowest;
+    } else {
+        return;
+    }
+    
+    aiUrgentRider[n] = handle;
+    aiUrgentLevel[n] = urgency;
+}
+
+u8 scheduleAIDecisions(void) {
+    u8 decisions = 0;
+    u8 k, n;
+    
+    // Tour de décisions : le rider du slot courant
+    u8 id = aiDecisionSlots[aiDecisionFrame & (AI_DECISION_SLOTS - 1)];
+    aiDecisionFrame++;
+    
+    if (id != AI_NO_RIDER) {
+        updateAIDecisions(id);
+        decisions++;
+    }
+    
+    // Décisions urgentes, la plus prioritaire d'abord
+    for (k = 0; k < AI_URGENT_PER_FRAME && aiUrgentCount > 0; k++) {
+        u8 best = 0;
+        
+        for (n = 1; n < aiUrgentCount; n++) {
+            if (aiUrgentLevel[n] > aiUrgentLevel[best]) best = n;
+        }
+        
+        id = resolveRiderHandle(aiUrgentRider[best]);
+        
+        // Retrait : la dernière entrée prend sa place
+        aiUrgentCount--;
+        aiUrgentRider[best] = aiUrgentRider[aiUrgentCount];
+        aiUrgentLevel[best] = aiUrgentLevel[aiUrgentCount];
+        
+        // Rider libéré depuis la demande : l'entrée est perdue
+        if (id == AI_NO_RIDER) continue;
+        
+        updateAIDecisions(id);
+        decisions++;
+    }
+    
+    return decisions;
+}
+
+// === DECISIONS ===
+
+void updateAIDecisions(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    
+    // Calcul de la distance au joueur
+    rider->playerDistance = abs(aiHot.x[id] - playerX);
+    
+    // Un seul saut indexé
+    aiHandlers[rider->aiType][rider->state](id);
+}
+
+// Trajectoire idéale à la position du rider, décalée selon sa personnalité
+static s16 racingLineTarget(u8 id, const AIParams* p) {
+    return ROAD_CENTER + racingLineX[getRacingLineIndex(aiHot.worldZ[id])] + p->lineOffset;
+}
+
+// Cible occupée par un rider devant (lookAhead unités) : couloir libre le
+// plus proche, pour doubler au lieu de percuter
+static s16 steerToFreeLane(u8 id, s16 targetX, const AIParams* p) {
+    if (p->lookAhead == 0) return targetX;
+    
+    s16 lane = findFreeLane(targetX, aiHot.worldZ[id], p->lookAhead);
+    return (lane != AI_LANE_NONE) ? lane : targetX;
+}
+
+static void clampTargetToRoad(u8 id) {
+    if (aiHot.targetX[id] < ROAD_TARGET_MIN) aiHot.targetX[id] = ROAD_TARGET_MIN;
+    if (aiHot.targetX[id] > ROAD_TARGET_MAX) aiHot.targetX[id] = ROAD_TARGET_MAX;
+}
+
+static void enterAttack(u8 id, const AIParams* p) {
+    aiRiders[id].state = AI_STATE_ATTACKING;
+    aiRiders[id].stateTimer = p->attackDuration;
+}
+
+// === COURSE (AI_STATE_RACING) ===
+
+void updateChaseAI(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    const AIParams* p = &aiParams[rider->aiType];
+    
+    // Fonce vers le joueur s'il est en vue et assez agressif, sinon ligne de course
+    if (rider->playerDistance < p->sightDistance && rider->aggressionLevel > p->chaseAggression) {
+        aiHot.targetX[id] = playerX + randomSpread(RANDOM_STREAM_AI, p->aimSpread);
+        if (rider->playerDistance < p->attackRange &&
+            randomChance(RANDOM_STREAM_AI, p->attackChance)) {
+            enterAttack(id, p);
+        }
+    } else {
+        aiHot.targetX[id] = steerToFreeLane(id,
+            racingLineTarget(id, p) + randomSpread(RANDOM_STREAM_AI, p->laneSpread), p);
+    }
+    
+    clampTargetToRoad(id);
+}
+
+void updateEvadeAI(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    const AIParams* p = &aiParams[rider->aiType];
+    s16 avoidanceX = 0;
+    
+    // Se tient à l'écart du joueur
+    if (rider->playerDistance < p->avoidDistance) {
+        avoidanceX = (aiHot.x[id] < playerX) ? -p->avoidOffset : p->avoidOffset;
+    }
+    
+    aiHot.targetX[id] = steerToFreeLane(id, racingLineTarget(id, p) + avoidanceX, p);
+    
+    // Changement d'état si trop proche
+    if (rider->playerDistance < p->panicDistance) {
+        rider->state = AI_STATE_AVOIDING;
+        rider->stateTimer = p->avoidDuration;
+    }
+    
+    clampTargetToRoad(id);
+}
+
+void updateWanderAI(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    const AIParams* p = &aiParams[rider->aiType];
+    
+    // Change de ligne au hasard
+    if (randomChance(RANDOM_STREAM_AI, p->wanderChance)) {
+        aiHot.targetX[id] = p->wanderMin + randomRangeASM(RANDOM_STREAM_AI, p->wanderRange);
+    }
+    
+    // Attaque occasionnelle
+    if (rider->playerDistance < p->attackRange && randomChance(RANDOM_STREAM_AI, p->attackChance)) {
+        enterAttack(id, p);
+    }
+    
+    clampTargetToRoad(id);
+}
+
+void updateBlockAI(u8 id) {
+    const AIParams* p = &aiParams[aiRiders[id].aiType];
+    
+    // Se place devant la trajectoire du joueur, si aucun rider n'y est devant lui
+    s16 blockX = playerX + randomSpread(RANDOM_STREAM_AI, p->aimSpread);
+    if (isLaneFree(blockX, aiHot.worldZ[id], p->lookAhead)) {
+        aiHot.targetX[id] = blockX;
+    }
+    
+    // Ralentit si devant le joueur
+    if (aiHot.worldZ[id] > (s32)(trackPosition << 16)) {
+        aiHot.speed[id] = min(aiHot.speed[id], playerSpeed + 1);
+    }
+    
+    clampTargetToRoad(id);
+}
+
+void updateRubberBandAI(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    const AIParams* p = &aiParams[rider->aiType];
+    s32 playerWorldZ = trackPosition << 16;
+    s32 distanceToPlayer = aiHot.worldZ[id] - playerWorldZ;
+    
+    // Rubber band - ajuste la vitesse selon la distance
+    if (distanceToPlayer > (RUBBER_BAND_DISTANCE << 16)) {
+        // Trop loin derrière - accélère
+        rider->state = AI_STATE_CATCHING_UP;
+        rider->stateTimer = 120;
+        aiHot.speed[id] = min(aiHot.maxSpeed[id] + 20, 255);
+    } else if (distanceToPlayer < -(RUBBER_BAND_DISTANCE << 16)) {
+        // Trop loin devant - ralentit
+        aiHot.speed[id] = max(aiHot.speed[id] - 2, aiHot.maxSpeed[id] >> 2);
+    } else {
+        // Distance correcte - vitesse normale
+        aiHot.speed[id] = aiHot.maxSpeed[id];
+    }
+    
+    // Position cible normale
+    aiHot.targetX[id] = steerToFreeLane(id,
+        racingLineTarget(id, p) + randomSpread(RANDOM_STREAM_AI, p->laneSpread), p);
+    
+    clampTargetToRoad(id);
+}
+
+// === ETATS COMMUNS ===
+
+void updateAttackingAI(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    const AIParams* p = &aiParams[rider->aiType];
+    
+    // Fonce vers le joueur
+    aiHot.targetX[id] = playerX;
+    aiHot.speed[id] = min(aiHot.speed[id] + 2, aiHot.maxSpeed[id] + p->attackSpeedBonus);
+    
+    // Vérification de collision pour attaque
+    if (rider->playerDistance < p->strikeRange && rider->canAttack) {
+        performAIAttack(id);
+    }
+    
+    // Timeout de l'attaque
+    if (rider->stateTimer > 0) {
+        rider->stateTimer--;
+    } else {
+        rider->state = AI_STATE_RACING;
+        rider->attackTimer = p->attackCooldown;
+    }
+}
+
+void updateAvoidingAI(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    const AIParams* p = &aiParams[rider->aiType];
+    
+    // Mouvement d'évitement : à l'opposé du joueur, de l'autre côté si un
+    // rider y est devant
+    s16 swerve = (aiHot.x[id] < playerX) ? -p->swerve : p->swerve;
+    if (!isLaneFree(aiHot.x[id] + swerve, aiHot.worldZ[id], AVOID_LOOKAHEAD) &&
+        isLaneFree(aiHot.x[id] - swerve, aiHot.worldZ[id], AVOID_LOOKAHEAD)) {
+        swerve = -swerve;
+    }
+    aiHot.targetX[id] = aiHot.x[id] + swerve;
+    
+    // Ralentit légèrement
+    aiHot.speed[id] = max(aiHot.speed[id] - 1, aiHot.maxSpeed[id] >> 2);
+    
+    if (rider->stateTimer > 0) {
+        rider->stateTimer--;
+    } else {
+        rider->state = AI_STATE_RACING;
+    }
+}
+
+void updateCrashedAI(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    
+    // Récupération après crash
+    aiHot.speed[id] = 0;
+    aiHot.targetX[id] = aiHot.x[id]; // Reste sur place
+    
+    if (rider->stateTimer > 0) {
+        rider->stateTimer--;
+    } else {
+        rider->state = AI_STATE_RACING;
+        aiHot.speed[id] = aiHot.maxSpeed[id] >> 2; // Redémarre lentement
+        rider->health = min(rider->health + aiParams[rider->aiType].crashHeal, 100);
+    }
+}
+
+void updateCatchingUpAI(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    const AIParams* p = &aiParams[rider->aiType];
+    
+    // Mode rattrapage accéléré
+    aiHot.speed[id] = min(aiHot.maxSpeed[id] + p->catchUpBonus, 255);
+    aiHot.targetX[id] = steerToFreeLane(id, racingLineTarget(id, p), p); // Trajectoire pour rattraper
+    
+    if (rider->stateTimer > 0) {
+        rider->stateTimer--;
+    } else {
+        rider->state = AI_STATE_RACING;
+    }
+}
@@ -0,0 +1,252 @@
+/* ai_field.c - Peloton persistant : simulation à deux niveaux des concurrents */
+
+#include <genesis.h>
+#include "ai_riders.h"
+#include "ai_field.h"
+#include "fast_random.h"
+#include "track.h"
+
+#define AI_FIELD_PROMOTE_Z   (450L << 16)  // Passage en simulation complète
+#define AI_FIELD_DEMOTE_Z    (550L << 16)  // Retour au modèle analytique
+#define AI_FIELD_SWAP_MARGIN (64L << 16)   // Écart minimal pour échanger deux places
+#define AI_FIELD_INCIDENT_FRAMES 150       // Durée d'une chute hors écran
+
+// Variables globales
+AIFieldEntry aiField[AI_FIELD_SIZE];
+u8 aiFieldCount = 0;
+u8 aiFieldOrder[AI_FIELD_SIZE];
+
+static u8 aiFieldFrame = 0;        // Horloge des mises à jour analytiques
+static u8 aiFieldCursor = 0;       // Prochaine entrée analytique à mettre à jour
+static u8 aiFieldActive = 0;       // Entrées simulées complètement
+
+// === INITIALISATION ===
+
+void initAIField(void) {
+    aiFieldCount = 0;
+    aiFieldFrame = 0;
+    aiFieldCursor = 0;
+    aiFieldActive = 0;
+}
+
+u8 addFieldEntry(AIType type, s32 worldZ, s16 laneX) {
+    if (aiFieldCount >= AI_FIELD_SIZE) return AI_NO_RIDER;
+    
+    u8 entry = aiFieldCount;
+    AIFieldEntry* e = &aiField[entry];
+    s16 maxSpeed = aiParams[type].maxSpeed;
+    
+    e->worldZ = worldZ;
+    e->laneX = laneX;
+    e->aiType = type;
+    e->rider = AI_NO_HANDLE;
+    e->incidentTimer = 0;
+    e->lastUpdate = aiFieldFrame;
+    
+    // Allure moyenne : profil de vitesse moyen du tour (même modèle que la
+    // physique, temps au tour cohérents), un peu de dispersion
+    e->pace = ((maxSpeed * racingLineAverage) >> RACING_SPEED_SHIFT) - randomRangeASM(RANDOM_STREAM_SPAWN, 8);
+    
+    // Nouvel arrivant en queue du classement, remis en place par updateAIField
+    aiFieldOrder[aiFieldCount++] = entry;
+    
+    return entry;
+}
+
+// === PROMOTION / RETROGRADATION ===
+
+void promoteFieldEntry(u8 entry) {
+    AIFieldEntry* e = &aiField[entry];
+    u8 id = spawnAIRider(e->aiType, e->worldZ, e->laneX);
+    
+    if (id == AI_NO_RIDER) return;
+    
+    aiRiders[id].fieldIndex = entry;
+    aiHot.speed[id] = e->pace;
+    
+    // Une chute en cours se poursuit en simulation complète
+    if (e->incidentTimer > 0) {
+        aiRiders[id].state = AI_STATE_CRASHED;
+        aiRiders[id].stateTimer = e->incidentTimer;
+        aiHot.speed[id] = 0;
+        e->incidentTimer = 0;
+    }
+    
+    e->rider = getRiderHandle(id);
+    aiFieldActive++;
+}
+
+void demoteFieldRider(u8 id) {
+    u8 entry = aiRiders[id].fieldIndex;
+    AIFieldEntry* e = &aiField[entry];
+    s16 maxSpeed = aiHot.maxSpeed[id];
+    
+    // Reprise de la position réelle ; l'allure garde les bonus de difficulté
+    e->worldZ = aiHot.worldZ[id];
+    e->pace = (maxSpeed * racingLineAverage) >> RACING_SPEED_SHIFT;
+    e->rider = AI_NO_HANDLE;
+    e->lastUpdate = aiFieldFrame;
+    
+    aiRiders[id].fieldIndex = AI_NO_RIDER;
+    disableAIRider(id);
+    aiFieldActive--;
+}
+
+// Concurrent mis hors course (KO, appelé par disableAIRider) : retiré du
+// peloton et du classement. La dernière entrée prend sa place ; son rider
+// simulé suit le nouvel index.
+void retireFieldEntry(u8 entry) {
+    u8 last, n, k;
+    
+    if (entry >= aiFieldCount) return;
+    
+    if (aiField[entry].rider != AI_NO_HANDLE) aiFieldActive--;
+    last = --aiFieldCount;
+    
+    // Classement : retrait de l'entrée, l'ordre reste trié
+    for (n = 0, k = 0; n <= last; n++) {
+        u8 other = aiFieldOrder[n];
+        
+        if (other == entry) continue;
+        aiFieldOrder[k++] = (other == last) ? entry : other;
+    }
+    
+    if (entry != last) {
+        u8 id;
+        
+        aiField[entry] = aiField[last];
+        id = resolveRiderHandle(aiField[entry].rider);
+        if (id != AI_NO_RIDER) aiRiders[id].fieldIndex = entry;
+    }
+    
+    if (aiFieldCursor >= aiFieldCount) aiFieldCursor = 0;
+}
+
+// Entrée simulée la plus éloignée du joueur (AI_NO_RIDER si aucune)
+static u8 findFarthestActiveEntry(s32 playerWorldZ, s32* distance) {
+    u8 farthest = AI_NO_RIDER;
+    s32 maxDistance = -1;
+    u8 n;
+    
+    for (n = 0; n < aiFieldCount; n++) {
+        AIFieldEntry* e = &aiField[n];
+        
+        if (e->rider == AI_NO_HANDLE) continue;
+        
+        s32 d = abs(e->worldZ - playerWorldZ);
+        if (d > maxDistance) {
+            maxDistance = d;
+            farthest = n;
+        }
+    }
+    
+    *distance = maxDistance;
+    return farthest;
+}
+
+// === MISE A JOUR ===
+
+static void updateFieldEntry(u8 entry, s32 playerWorldZ) {
+    AIFieldEntry* e = &aiField[entry];
+    const AIParams* p = &aiParams[e->aiType];
+    u8 elapsed = aiFieldFrame - e->lastUpdate;
+    
+    e->lastUpdate = aiFieldFrame;
+    
+    // Chute en cours : le temps passé à terre ne fait pas avancer
+    if (e->incidentTimer > 0) {
+        u8 lost = min(elapsed, e->incidentTimer);
+        e->incidentTimer -= lost;
+        elapsed -= lost;
+    } else if ((fastRandomASM(RANDOM_STREAM_AI) & 0xFF) < p->incidentChance) {
+        e->incidentTimer = AI_FIELD_INCIDENT_FRAMES;
+    }
+    
+    // Même échelle que la physique : worldZ += speed << 14 par frame
+    e->worldZ += ((s32)e->pace * elapsed) << 14;
+    
+    // Proche du joueur : passage en simulation complète
+    s32 distance = abs(e->worldZ - playerWorldZ);
+    if (distance >= AI_FIELD_PROMOTE_Z) return;
+    
+    if (aiFieldActive >= AI_FIELD_MAX_ACTIVE) {
+        // Places prises : échange avec la plus éloignée si nettement plus loin
+        s32 farthestDistance;
+        u8 farthest = findFarthestActiveEntry(playerWorldZ, &farthestDistance);
+        
+        if (farthest == AI_NO_RIDER ||
+            farthestDistance <= distance + AI_FIELD_SWAP_MARGIN) return;
+        
+        demoteFieldRider(resolveRiderHandle(aiField[farthest].rider));
+    }
+    
+    promoteFieldEntry(entry);
+}
+
+void updateAIField(void) {
+    s32 playerWorldZ = trackPosition << 16;
+    u8 n, k;
+    
+    if (aiFieldCount == 0) return;
+    
+    aiFieldFrame++;
+    
+    // Entrées simulées : position réelle, retour au modèle analytique si loin
+    for (n = 0; n < aiFieldCount; n++) {
+        AIFieldEntry* e = &aiField[n];
+        if (e->rider == AI_NO_HANDLE) continue;
+        
+        // Handle toujours valide : une rétrogradation l'efface, un KO retire
+        // l'entrée (retireFieldEntry)
+        u8 id = resolveRiderHandle(e->rider);
+        
+        e->worldZ = aiHot.worldZ[id];
+        
+        if (abs(e->worldZ - playerWorldZ) > AI_FIELD_DEMOTE_Z) {
+            demoteFieldRider(id);
+        }
+    }
+    
+    // Quelques entrées analytiques par frame, à tour de rôle
+    for (k = 0; k < AI_FIELD_UPDATES && k < aiFieldCount; k++) {
+        u8 entry = aiFieldCursor;
+        
+        if (++aiFieldCursor >= aiFieldCount) aiFieldCursor = 0;
+        if (aiField[entry].rider != AI_NO_HANDLE) continue;
+        
+        updateFieldEntry(entry, playerWorldZ);
+    }
+    
+    // Classement : tri par insertion, O(n) sans dépassement
+    for (n = 1; n < aiFieldCount; n++) {
+        u8 entry = aiFieldOrder[n];
+        s32 z = aiField[entry].worldZ;
+        
+        k = n;
+        while (k > 0 && aiField[aiFieldOrder[k - 1]].worldZ < z) {
+            aiFieldOrder[k] = aiFieldOrder[k - 1];
+            k--;
+        }
+        aiFieldOrder[k] = entry;
+    }
+}
+
+// === CLASSEMENT ===
+
+u8 getFieldPosition(s32 worldZ) {
+    u8 lo = 0;
+    u8 hi = aiFieldCount;
+    
+    // Nombre de concurrents devant worldZ, + 1
+    while (lo < hi) {
+        u8 mid = (lo + hi) >> 1;
+        
+        if (aiField[aiFieldOrder[mid]].worldZ > worldZ) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    
+    return lo + 1;
+}
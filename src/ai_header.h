@@ -121,9 +121,8 @@ AIRider* getNearestRider(s16 playerX);
 
 extern void updateAIPhysicsASM(AIRider* rider, s16 targetX, s16 roadCurve);
 extern bool checkCollisionASM(s16 x1, s16 y1, s16 x2, s16 y2, s16 threshold);
-extern void sortRidersByDistance(AIRider* riders, u8 count);
 extern void calculateAISpacing(AIRider* riders, u8 count, s16 playerSpeed);
-extern u16 fastRandomASM(void);
+extern u16 fastRandomASM(u16 stream);
 extern void updateAIBehaviorFlagsASM(AIRider* riders, u8 count, u16 frameCounter);
 extern void calculateRelativePositions(AIRider* riders, u8 count, s16 playerX, s32 playerZ);
 
@@ -4,38 +4,76 @@
 #include "resources.h"
 #include "ai_riders.h"
 #include "ai_integration.h"
-
-// Points de spawn prédéfinis pour différents types de niveaux
+#include "ai_field.h"
+#include "fast_random.h"
+#include "ai_lanes.h"
+#include "track.h"
+#include "entity.h"
+#include "palettes.h"
+#include "text_buffer.h"
+
+// Points de spawn prédéfinis pour différents types de niveaux : position
+// absolue sur la piste, triés, consommés dans l'ordre par spawnCursor
 const AISpawnPoint citySpawns[] = {
-    { 200, AI_AGGRESSIVE, 120, 180 },
-    { 350, AI_DEFENSIVE, 200, 150 },
-    { 450, AI_BLOCKER, 160, 100 },
-    { 600, AI_ERRATIC, 140, 120 },
-    { 750, AI_RUBBER_BAND, 180, 200 },
-    { 0, 0, 0, 0 }  // Terminateur
+    { 200, AI_AGGRESSIVE, 120, 180, ENTITY_RIDER },
+    { 350, AI_DEFENSIVE, 200, 150, ENTITY_RIDER },
+    { 450, AI_BLOCKER, 160, 100, ENTITY_RIDER },
+    { 600, AI_ERRATIC, 140, 120, ENTITY_RIDER },
+    { 750, AI_RUBBER_BAND, 180, 200, ENTITY_RIDER },
+    { 850, AI_ROOKIE, 150, 160, ENTITY_RIDER },
+    { 0, 0, 0, 0, ENTITY_RIDER }  // Terminateur
 };
 
 const AISpawnPoint highwaySpawns[] = {
-    { 150, AI_RUBBER_BAND, 140, 200 },
-    { 280, AI_AGGRESSIVE, 180, 160 },
-    { 400, AI_DEFENSIVE, 120, 140 },
-    { 520, AI_ERRATIC, 200, 100 },
-    { 650, AI_BLOCKER, 160, 120 },
-    { 800, AI_AGGRESSIVE, 220, 180 },
-    { 0, 0, 0, 0 }
+    { 150, AI_RUBBER_BAND, 140, 200, ENTITY_RIDER },
+    { 280, AI_AGGRESSIVE, 180, 160, ENTITY_RIDER },
+    { 400, AI_DEFENSIVE, 120, 140, ENTITY_RIDER },
+    { 480, 0, 200, 150, ENTITY_TRAFFIC },
+    { 520, AI_ERRATIC, 200, 100, ENTITY_RIDER },
+    { 650, AI_BLOCKER, 160, 120, ENTITY_RIDER },
+    { 800, AI_AGGRESSIVE, 220, 180, ENTITY_RIDER },
+    { 900, AI_VETERAN, 160, 140, ENTITY_RIDER },
+    { 0, 0, 0, 0, ENTITY_RIDER }
 };
 
 const AISpawnPoint mountainSpawns[] = {
-    { 300, AI_DEFENSIVE, 160, 180 },
-    { 450, AI_RUBBER_BAND, 140, 160 },
-    { 600, AI_ERRATIC, 180, 120 },
-    { 750, AI_AGGRESSIVE, 200, 140 },
-    { 0, 0, 0, 0 }
+    { 300, AI_DEFENSIVE, 160, 180, ENTITY_RIDER },
+    { 450, AI_RUBBER_BAND, 140, 160, ENTITY_RIDER },
+    { 600, AI_ERRATIC, 180, 120, ENTITY_RIDER },
+    { 700, 0, 160, 200, ENTITY_PICKUP },
+    { 750, AI_AGGRESSIVE, 200, 140, ENTITY_RIDER },
+    { 850, AI_BRAWLER, 170, 160, ENTITY_RIDER },
+    { 0, 0, 0, 0, ENTITY_RIDER }
+};
+
+// Listes de spawns de segment (TRACK_EVENT_SPAWNS) : position relative au
+// début du segment, triées. Index = TRACK_EVENT_LIST(eventFlags).
+static const AISpawnPoint ambushSpawns[] = {
+    { 10, AI_AGGRESSIVE, 140, 255, ENTITY_RIDER },
+    { 25, 0, 160, 255, ENTITY_OIL_SLICK },
+    { 40, AI_AGGRESSIVE, 180, 200, ENTITY_RIDER },
+    { 0, 0, 0, 0, ENTITY_RIDER }
 };
 
+static const AISpawnPoint* const segmentSpawnLists[] = {
+    ambushSpawns
+};
+
+#define SEGMENT_SPAWN_LISTS (sizeof(segmentSpawnLists) / sizeof(segmentSpawnLists[0]))
+
+// Grille de départ du peloton (unités devant le joueur, écart entre places)
+#define FIELD_GRID_FRONT 300
+#define FIELD_GRID_GAP 40
+
+// Durée du flash de collision (frames)
+#define COLLISION_FLASH_FRAMES 4
+
 // Variables globales
 static const AISpawnPoint* currentSpawns = citySpawns;
-static u16 lastSpawnCheck = 0;
+static const AISpawnPoint* spawnCursor = citySpawns;   // Prochain point du niveau
+static const AISpawnPoint* segmentCursor = NULL;       // Prochain point du segment
+static s32 segmentSpawnBase = 0;                       // Début du segment armé
+static u32 raceSeed = RANDOM_RACE_SEED;               // Graine du niveau courant
 static u16 frameCounter = 0;
 static u8 difficultyLevel = 1;  // 1-5, influence le comportement IA
 
@@ -72,68 +110,110 @@ void initAIForLevel(u8 levelType) {
             break;
     }
     
+    spawnCursor = currentSpawns;
+    segmentCursor = NULL;
+    
+    // Tirages reproductibles : même niveau, même course (reset compris)
+    raceSeed = RANDOM_RACE_SEED + levelType;
+    seedRandomStreams(raceSeed);
+    
     // Initialisation du système IA
     initAISystem();
     
     // Spawn initial de quelques riders
     spawnInitialRiders();
     
-    VDP_drawText("AI LEVEL READY", 1, 2);
+    drawTimedText("AI LEVEL READY", 1, 5, 120);
 }
 
 void spawnInitialRiders(void) {
     u8 i;
     const AISpawnPoint* spawn = currentSpawns;
     
-    // Spawn 2-3 riders au début selon la difficulté
-    u8 initialCount = 2 + (difficultyLevel >> 1);
+    // Peloton de 16 à 20 concurrents selon la difficulté
+    u8 fieldCount = min(14 + (difficultyLevel << 1), AI_FIELD_SIZE);
+    
+    initAIField();
     
-    for (i = 0; i < initialCount && spawn->spawnDistance != 0; i++, spawn++) {
-        s32 spawnZ = (trackPosition + spawn->spawnDistance) << 16;
-        spawnAIRider(spawn->aiType, spawnZ, spawn->laneX);
+    // Grille de départ autour du joueur ; types et lignes pris dans les
+    // points de spawn du niveau, en boucle
+    for (i = 0; i < fieldCount; i++) {
+        // Seuls les points de riders forment le peloton
+        while (spawn->kind != ENTITY_RIDER) {
+            spawn++;
+            if (spawn->spawnDistance == 0) spawn = currentSpawns;
+        }
+        
+        s32 gridZ = (trackPosition + FIELD_GRID_FRONT - i * FIELD_GRID_GAP) << 16;
+        
+        addFieldEntry(spawn->aiType, gridZ, spawn->laneX);
         aiStats.totalSpawned++;
+        
+        spawn++;
+        if (spawn->spawnDistance == 0) spawn = currentSpawns;
     }
 }
 
-void updateAISpawning(void) {
-    const AISpawnPoint* spawn = currentSpawns;
-    u16 currentDistance = trackPosition >> 4; // Distance parcourue /16
+// Entités vivantes issues des points de spawn : tout ce qui n'est pas un
+// concurrent promu du peloton (ceux-là sont bornés par AI_FIELD_MAX_ACTIVE)
+static u8 countSpawnedEntities(void) {
+    u8 count = 0;
+    u8 n;
     
-    // Vérification de spawn seulement toutes les 15 frames
-    if ((frameCounter % 15) != 0) return;
+    for (n = 0; n < activeRiders; n++) {
+        if (aiRiders[aiLive[n]].fieldIndex == AI_NO_RIDER) count++;
+    }
     
-    // Parcours des points de spawn
-    while (spawn->spawnDistance != 0) {
-        u16 spawnDist = lastSpawnCheck + spawn->spawnDistance;
-        
-        if (currentDistance >= spawnDist) {
-            // Vérification probabiliste
-            u16 rand = random() & 0xFF;
-            u8 adjustedProb = spawn->probability;
-            
-            // Ajustement de probabilité selon la difficulté
-            adjustedProb = (adjustedProb * difficultyLevel) / 3;
-            if (adjustedProb > 255) adjustedProb = 255;
-            
-            if (rand < adjustedProb) {
-                // Calcul de la position de spawn
-                s32 spawnZ = (trackPosition + (spawn->spawnDistance << 4)) << 16;
-                s16 laneVariation = (random() % 40) - 20; // ±20 pixels
-                s16 finalX = spawn->laneX + laneVariation;
-                
-                // Vérification qu'on n'a pas trop de riders actifs
-                if (getActiveRiderCount() < (4 + difficultyLevel)) {
-                    spawnAIRider(spawn->aiType, spawnZ, finalX);
-                    aiStats.totalSpawned++;
-                }
-            }
-            
-            lastSpawnCheck = currentDistance;
-        }
-        spawn++;
+    return count;
+}
+
+// Un point de spawn franchi par le joueur : tirage puis apparition devant lui
+static void fireSpawnPoint(const AISpawnPoint* spawn) {
+    u16 rand = fastRandomASM(RANDOM_STREAM_SPAWN) & 0xFF;
+    
+    // Ajustement de probabilité selon la difficulté
+    u16 adjustedProb = (spawn->probability * difficultyLevel) / 3;
+    if (adjustedProb > 255) adjustedProb = 255;
+    
+    if (rand >= adjustedProb) return;
+    
+    // Vérification qu'on n'a pas trop d'entités de spawn actives (le pool
+    // plein est refusé par l'allocation)
+    if (countSpawnedEntities() >= (4 + difficultyLevel)) return;
+    
+    s32 spawnZ = (trackPosition + AI_SPAWN_AHEAD) << 16;
+    s16 finalX = spawn->laneX + randomSpread(RANDOM_STREAM_SPAWN, 20); // ±20 pixels
+    
+    u8 id = (spawn->kind == ENTITY_RIDER) ? spawnAIRider(spawn->aiType, spawnZ, finalX)
+                                          : spawnEntity(spawn->kind, spawnZ, finalX);
+    
+    if (id != AI_NO_RIDER) {
+        aiStats.totalSpawned++;
     }
 }
 
+void updateAISpawning(void) {
+    // Curseurs sur des tables triées : une comparaison par frame, chaque
+    // point déclenché exactement une fois (plusieurs si franchis d'un coup)
+    while (spawnCursor->spawnDistance != 0 && trackPosition >= spawnCursor->spawnDistance) {
+        fireSpawnPoint(spawnCursor++);
+    }
+    
+    while (segmentCursor != NULL &&
+           trackPosition >= segmentSpawnBase + segmentCursor->spawnDistance) {
+        fireSpawnPoint(segmentCursor++);
+        if (segmentCursor->spawnDistance == 0) segmentCursor = NULL;
+    }
+}
+
+void armSegmentSpawns(u8 list, s32 segmentStart) {
+    // Appelé à l'entrée d'un segment marqué TRACK_EVENT_SPAWNS
+    if (list >= SEGMENT_SPAWN_LISTS) return;
+    
+    segmentCursor = segmentSpawnLists[list];
+    segmentSpawnBase = segmentStart;
+}
+
 void updateAIDifficulty(void) {
     // Augmentation progressive de la difficulté
     static u16 difficultyTimer = 0;
@@ -150,7 +230,7 @@ void updateAIDifficulty(void) {
             // Notification visuelle
             char diffText[20];
             sprintf(diffText, "DIFFICULTY: %d", difficultyLevel);
-            VDP_drawText(diffText, 1, 3);
+            drawTimedText(diffText, 1, 3, 120);
             
             // Boost de tous les riders actifs
             boostActiveRiders();
@@ -159,19 +239,21 @@ void updateAIDifficulty(void) {
 }
 
 void boostActiveRiders(void) {
-    u8 i;
+    u8 n;
     
-    for (i = 0; i < MAX_AI_RIDERS; i++) {
-        if (aiRiders[i].active) {
-            // Augmentation des stats selon la difficulté
-            aiRiders[i].maxSpeed += (difficultyLevel * 5);
-            aiRiders[i].aggressionLevel = min(aiRiders[i].aggressionLevel + 20, 255);
-            aiRiders[i].acceleration += 1;
-            
-            // Limitation pour éviter les valeurs extrêmes
-            if (aiRiders[i].maxSpeed > 280) {
-                aiRiders[i].maxSpeed = 280;
-            }
+    for (n = 0; n < activeRiders; n++) {
+        u8 i = aiLive[n];
+        
+        if (!(aiHot.flags[i] & ENT_FLAG_AI)) continue;
+        
+        // Augmentation des stats selon la difficulté
+        aiHot.maxSpeed[i] += (difficultyLevel * 5);
+        aiRiders[i].aggressionLevel = min(aiRiders[i].aggressionLevel + 20, 255);
+        aiHot.acceleration[i] += 1;
+        
+        // Limitation pour éviter les valeurs extrêmes
+        if (aiHot.maxSpeed[i] > 280) {
+            aiHot.maxSpeed[i] = 280;
         }
     }
 }
@@ -179,57 +261,56 @@ void boostActiveRiders(void) {
 // === INTEGRATION AVEC LE SYSTEME DE COLLISION ===
 
 void handlePlayerAIInteraction(void) {
-    u8 i;
+    u8 n;
     
-    for (i = 0; i < MAX_AI_RIDERS; i++) {
-        if (!aiRiders[i].active || !aiRiders[i].visible) continue;
+    for (n = 0; n < activeRiders; n++) {
+        u8 i = aiLive[n];
         
-        AIRider* rider = &aiRiders[i];
-        s16 distance = abs(rider->x - playerX);
+        if ((aiHot.flags[i] & (AI_FLAG_VISIBLE | ENT_FLAG_AI)) !=
+            (AI_FLAG_VISIBLE | ENT_FLAG_AI)) continue;
+        
+        s16 distance = abs(aiHot.x[i] - playerX);
         
         // Interaction proche (pas forcément collision)
         if (distance < 40) {
-            handleCloseInteraction(rider);
-        }
-        
-        // Vérification collision précise
-        if (checkCollisionASM(rider->x, rider->y, playerX, 190, 18)) {
-            handlePlayerAICollision(rider);
-            aiStats.collisionChecks++;
-            
-            // Effets visuels/sonores de collision
-            triggerCollisionEffects(rider->x, rider->y);
+            handleCloseInteraction(i);
         }
     }
+    
+    // Les collisions (joueur compris) sont résolues par checkAICollisions
+    aiStats.collisionChecks += aiContactCount;
 }
 
-void handleCloseInteraction(AIRider* rider) {
+void handleCloseInteraction(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    const AIParams* p = &aiParams[rider->aiType];
+    s16 x = aiHot.x[id];
+    s16 blockX;
+    
     // Interactions non-collision (intimidation, blocage, etc.)
-    switch (rider->aiType) {
-        case AI_AGGRESSIVE:
-            // Essaie d'intimider le joueur
-            if (rider->x < playerX + 20 && rider->x > playerX - 20) {
-                // Réduction légère de la vitesse joueur
-                if (playerSpeed > 0) {
-                    playerSpeed = max(playerSpeed - 1, 0);
-                }
+    if (abs(x - playerX) >= p->closeRange) return;
+    
+    switch (p->closeAction) {
+        case AI_CLOSE_INTIMIDATE:
+            // Réduction légère de la vitesse joueur
+            if (playerSpeed > 0) {
+                playerSpeed = max(playerSpeed - 1, 0);
             }
             break;
             
-        case AI_BLOCKER:
-            // Ajuste sa position pour bloquer
-            if (abs(rider->x - playerX) < 30) {
-                rider->targetX = playerX + ((rider->x < playerX) ? -15 : 15);
-                rider->speed = min(rider->speed, playerSpeed + 1);
+        case AI_CLOSE_BLOCK:
+            // Ajuste sa position pour bloquer, sans couper la route d'un rider
+            blockX = playerX + ((x < playerX) ? -15 : 15);
+            if (isLaneFree(blockX, aiHot.worldZ[id], p->lookAhead)) {
+                aiHot.targetX[id] = blockX;
             }
+            aiHot.speed[id] = min(aiHot.speed[id], playerSpeed + 1);
             break;
             
-        case AI_DEFENSIVE:
+        case AI_CLOSE_AVOID:
             // S'écarte activement
-            if (rider->x < playerX + 25 && rider->x > playerX - 25) {
-                rider->state = AI_STATE_AVOIDING;
-                rider->stateTimer = 60;
-            }
+            rider->state = AI_STATE_AVOIDING;
+            rider->stateTimer = 60;
             break;
             
         default:
@@ -238,17 +319,14 @@ void handleCloseInteraction(AIRider* rider) {
 }
 
 void triggerCollisionEffects(s16 x, s16 y) {
-    // Effet visuel simple - flash de l'écran
-    PAL_setColor(0, 0x0EEE); // Flash blanc
+    // Flash blanc du fond (couleur 0), rétabli par le gestionnaire de palettes
+    flashPalette(0, 1, 0x0EEE, COLLISION_FLASH_FRAMES);
     
     // Note: Ici tu peux ajouter:
     // - Particules de crash
     // - Effets sonores
     // - Shake de caméra
     // - Score/dégâts
-    
-    // Reset de la couleur après quelques frames
-    // (à implémenter avec un timer)
 }
 
 // === GESTION DE LA PERFORMANCE ===
@@ -262,56 +340,41 @@ void optimizeAIPerformance(void) {
     if (optimizeCounter >= 60) {
         optimizeCounter = 0;
         
-        // Tri des riders par distance pour optimiser le culling
-        sortRidersByDistance(aiRiders, activeRiders);
-        
         // Désactivation des riders trop éloignés
+        // (la fréquence de mise à jour par distance est gérée par scheduleAILOD)
         cullDistantRiders();
-        
-        // Réduction de la fréquence de mise à jour pour les riders éloignés
-        adjustUpdateFrequency();
     }
 }
 
 void cullDistantRiders(void) {
-    u8 i;
     s32 playerWorldZ = trackPosition << 16;
     const s32 maxDistance = 800 << 16; // 800 unités max
     
-    for (i = 0; i < MAX_AI_RIDERS; i++) {
-        if (!aiRiders[i].active) continue;
-        
-        s32 distance = abs(aiRiders[i].worldZ - playerWorldZ);
-        
-        if (distance > maxDistance) {
-            // Désactivation du rider éloigné
-            disableAIRider(&aiRiders[i]);
-        }
+    // Les riders trop éloignés sont aux extrémités de l'ordre de course.
+    // Le retrait de la tête y met le dernier : ordre rétabli à chaque tour
+    while (aiOrderCount > 0 &&
+           aiHot.worldZ[aiOrder[0]] - playerWorldZ > maxDistance) {
+        releaseDistantRider(aiOrder[0]);
+        updateRiderOrder();
+    }
+    while (aiOrderCount > 0 &&
+           playerWorldZ - aiHot.worldZ[aiOrder[aiOrderCount - 1]] > maxDistance) {
+        releaseDistantRider(aiOrder[aiOrderCount - 1]);
     }
 }
 
-void adjustUpdateFrequency(void) {
-    u8 i;
-    s32 playerWorldZ = trackPosition << 16;
-    
-    for (i = 0; i < MAX_AI_RIDERS; i++) {
-        if (!aiRiders[i].active) continue;
-        
-        s32 distance = abs(aiRiders[i].worldZ - playerWorldZ);
-        
-        // Réduction de fréquence pour les riders éloignés
-        if (distance > (300 << 16)) {
-            // Mise à jour une frame sur deux
-            if ((frameCounter & 1) == (i & 1)) {
-                continue; // Skip cette frame
-            }
-        }
+void releaseDistantRider(u8 id) {
+    // Un concurrent du peloton repasse au modèle analytique, les autres disparaissent
+    if (aiRiders[id].fieldIndex != AI_NO_RIDER) {
+        demoteFieldRider(id);
+    } else {
+        disableAIRider(id);
     }
 }
 
 // === INTERFACE PUBLIQUE POUR LE MOTEUR PRINCIPAL ===
 
-void updateFullAISystem(s16 roadCurve) {
+void updateFullAISystem(void) {
     frameCounter++;
     
     // Reset des stats de frame
@@ -319,6 +382,9 @@ void updateFullAISystem(s16 roadCurve) {
     aiStats.collisionChecks = 0;
     aiStats.visibleRiders = 0;
     
+    // Peloton : modèle analytique, promotions et classement
+    updateAIField();
+    
     // Mise à jour du spawning
     updateAISpawning();
     
@@ -326,7 +392,7 @@ void updateFullAISystem(s16 roadCurve) {
     updateAIDifficulty();
     
     // Mise à jour du système IA principal
-    updateAISystem(roadCurve);
+    updateAISystem();
     
     // Interactions avec le joueur
     handlePlayerAIInteraction();
@@ -339,17 +405,15 @@ void updateFullAISystem(s16 roadCurve) {
 }
 
 void updateAIStatistics(void) {
-    u8 i, visible = 0;
+    u8 n, visible = 0;
     
     // Comptage des riders visibles
-    for (i = 0; i < MAX_AI_RIDERS; i++) {
-        if (aiRiders[i].active && aiRiders[i].visible) {
-            visible++;
-        }
+    for (n = 0; n < activeRiders; n++) {
+        if (aiHot.flags[aiLive[n]] & AI_FLAG_VISIBLE) visible++;
     }
     
     aiStats.visibleRiders = visible;
-    aiStats.aiUpdatesPerFrame = activeRiders;
+    aiStats.aiUpdatesPerFrame = aiLodUpdates;
     
     // Affichage debug (optionnel)
     #ifdef DEBUG_AI
@@ -362,65 +426,77 @@ void displayAIDebugInfo(void) {
     char debugText[32];
     
     sprintf(debugText, "RIDERS:%d VIS:%d", activeRiders, aiStats.visibleRiders);
-    VDP_drawText(debugText, 1, 26);
+    drawBufferedText(debugText, 1, 26);
     
     sprintf(debugText, "DIFF:%d SPAWN:%d", difficultyLevel, aiStats.totalSpawned);
-    VDP_drawText(debugText, 1, 27);
+    drawBufferedText(debugText, 1, 27);
 }
 #endif
 
 // === FONCTIONS UTILITAIRES ===
 
 u8 getActiveRiderCount(void) {
-    u8 count = 0, i;
-    
-    for (i = 0; i < MAX_AI_RIDERS; i++) {
-        if (aiRiders[i].active) count++;
-    }
-    
-    return count;
+    return activeRiders;
 }
 
-AIRider* getNearestRider(s16 playerX) {
-    u8 i;
-    AIRider* nearest = NULL;
+AIHandle getNearestRider(s16 playerX) {
+    s32 playerWorldZ = trackPosition << 16;
+    u8 nearest = AI_NO_RIDER;
     s16 minDistance = 1000;
+    u8 n;
     
-    for (i = 0; i < MAX_AI_RIDERS; i++) {
-        if (!aiRiders[i].active || !aiRiders[i].visible) continue;
+    // Seuls les riders à hauteur du joueur (fenêtre Z) sont candidats :
+    // on part de la position du joueur dans l'ordre et on s'écarte des deux côtés
+    n = findOrderIndexForZ(playerWorldZ + AI_NEAR_Z_WINDOW);
+    
+    for (; n < aiOrderCount; n++) {
+        u8 i = aiOrder[n];
+        
+        if (aiHot.worldZ[i] < playerWorldZ - AI_NEAR_Z_WINDOW) break;
+        if ((aiHot.flags[i] & (AI_FLAG_VISIBLE | ENT_FLAG_AI)) !=
+            (AI_FLAG_VISIBLE | ENT_FLAG_AI)) continue;
         
-        s16 distance = abs(aiRiders[i].x - playerX);
+        s16 distance = abs(aiHot.x[i] - playerX);
         if (distance < minDistance) {
             minDistance = distance;
-            nearest = &aiRiders[i];
+            nearest = i;
         }
     }
     
-    return nearest;
+    return (nearest == AI_NO_RIDER) ? AI_NO_HANDLE : getRiderHandle(nearest);
+}
+
+u8 getPlayerRacePosition(void) {
+    // Classement dans le peloton complet, simulé ou non
+    return getFieldPosition(trackPosition << 16);
 }
 
 void resetAISystem(void) {
-    u8 i;
-    
-    // Désactivation de tous les riders
-    for (i = 0; i < MAX_AI_RIDERS; i++) {
-        if (aiRiders[i].active) {
-            disableAIRider(&aiRiders[i]);
-        }
+    // Plus de peloton jusqu'au prochain spawnInitialRiders ; vidé d'abord,
+    // les riders libérés n'ont plus d'entrée à retirer
+    initAIField();
+    
+    // Désactivation de tous les riders (par la fin : le retrait déplace
+    // le dernier vivant à la place du rider libéré)
+    while (activeRiders > 0) {
+        disableAIRider(aiLive[activeRiders - 1]);
     }
     
+    // Reprise de la suite de tirages du niveau au début
+    seedRandomStreams(raceSeed);
+    
     // Reset des statistiques
     aiStats.totalSpawned = 0;
     aiStats.aiUpdatesPerFrame = 0;
     aiStats.collisionChecks = 0;
     aiStats.visibleRiders = 0;
     
-    activeRiders = 0;
     frameCounter = 0;
-    lastSpawnCheck = 0;
+    spawnCursor = currentSpawns;
+    segmentCursor = NULL;
     difficultyLevel = 1;
     
-    VDP_drawText("AI SYSTEM RESET", 1, 1);
+    drawTimedText("AI SYSTEM RESET", 1, 4, 120);
 }
 
 // === SAUVEGARDE/CHARGEMENT ÉTAT IA (optionnel) ===
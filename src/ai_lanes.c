@@ -0,0 +1,101 @@
+/* ai_lanes.c - Carte d'occupation des couloirs devant le joueur */
+
+#include <genesis.h>
+#include "ai_riders.h"
+#include "ai_lanes.h"
+
+#define LANE_ROAD_MIN 80           // Couloirs candidats de findFreeLane,
+#define LANE_ROAD_MAX 240          // mêmes bornes que les cibles de l'IA
+
+u16 aiLaneMap[AI_LANE_BUCKETS];
+s32 aiLaneBaseZ = 0;
+
+// Bits des couloirs couverts par [x - halfWidth, x + halfWidth]
+static u16 laneMask(s16 x, s16 halfWidth) {
+    s16 lo = (x - halfWidth - AI_LANE_ORIGIN) >> AI_LANE_SHIFT;
+    s16 hi = (x + halfWidth - AI_LANE_ORIGIN) >> AI_LANE_SHIFT;
+    
+    if (hi < 0 || lo >= AI_LANE_COUNT) return 0;
+    if (lo < 0) lo = 0;
+    if (hi >= AI_LANE_COUNT) hi = AI_LANE_COUNT - 1;
+    
+    return (u16)((2UL << hi) - (1UL << lo));
+}
+
+// Couloirs occupés dans les tranches strictement après celle de worldZ,
+// jusqu'à worldZ + distance. La tranche de départ est exclue : c'est celle
+// du rider qui interroge, qui ne doit pas se voir lui-même.
+static u16 laneMapAhead(s32 worldZ, u16 distance) {
+    s32 first = ((worldZ - aiLaneBaseZ) >> AI_LANE_BUCKET_SHIFT) + 1;
+    s32 last = (worldZ + ((s32)distance << 16) - aiLaneBaseZ) >> AI_LANE_BUCKET_SHIFT;
+    u16 occupied = 0;
+    
+    // Hors de la fenêtre : rien n'est connu, la route est supposée libre
+    if (first < 0) first = 0;
+    if (last >= AI_LANE_BUCKETS) last = AI_LANE_BUCKETS - 1;
+    
+    for (; first <= last; first++) {
+        occupied |= aiLaneMap[first];
+    }
+    
+    return occupied;
+}
+
+void markLaneObstacle(s32 worldZ, s16 x, s16 halfWidth) {
+    s32 offset = worldZ - aiLaneBaseZ;
+    
+    if (offset < 0) return;
+    
+    offset >>= AI_LANE_BUCKET_SHIFT;
+    if (offset >= AI_LANE_BUCKETS) return;
+    
+    aiLaneMap[offset] |= laneMask(x, halfWidth);
+}
+
+void buildLaneMap(void) {
+    s32 playerWorldZ = trackPosition << 16;
+    s32 endZ;
+    u8 n;
+    
+    aiLaneBaseZ = playerWorldZ - AI_LANE_BEHIND;
+    endZ = aiLaneBaseZ + ((s32)AI_LANE_BUCKETS << AI_LANE_BUCKET_SHIFT);
+    
+    for (n = 0; n < AI_LANE_BUCKETS; n++) {
+        aiLaneMap[n] = 0;
+    }
+    
+    // Une passe sur la portion de l'ordre de course couverte par la fenêtre
+    for (n = findOrderIndexForZ(endZ - 1); n < aiOrderCount; n++) {
+        u8 id = aiOrder[n];
+        
+        if (aiHot.worldZ[id] < aiLaneBaseZ) break;
+        if (!(aiHot.flags[id] & ENT_FLAG_SOLID)) continue;
+        
+        markLaneObstacle(aiHot.worldZ[id], aiHot.x[id], AI_LANE_HALF_WIDTH);
+    }
+    
+    // Le joueur occupe aussi la route
+    markLaneObstacle(playerWorldZ, playerX, AI_LANE_HALF_WIDTH);
+}
+
+bool isLaneFree(s16 x, s32 worldZ, u16 distance) {
+    return (laneMapAhead(worldZ, distance) & laneMask(x, AI_LANE_HALF_WIDTH)) == 0;
+}
+
+s16 findFreeLane(s16 x, s32 worldZ, u16 distance) {
+    u16 occupied = laneMapAhead(worldZ, distance);
+    s16 step;
+    
+    if (!(occupied & laneMask(x, AI_LANE_HALF_WIDTH))) return x;
+    
+    // Couloir libre le plus proche, en alternant droite et gauche
+    for (step = 1 << AI_LANE_SHIFT; step <= LANE_ROAD_MAX - LANE_ROAD_MIN; step += 1 << AI_LANE_SHIFT) {
+        s16 right = x + step;
+        s16 left = x - step;
+        
+        if (right <= LANE_ROAD_MAX && !(occupied & laneMask(right, AI_LANE_HALF_WIDTH))) return right;
+        if (left >= LANE_ROAD_MIN && !(occupied & laneMask(left, AI_LANE_HALF_WIDTH))) return left;
+    }
+    
+    return AI_LANE_NONE;
+}
@@ -1,215 +1,342 @@
 /* ai_physics.s - Routines assembleur optimisées pour l'IA des concurrents */
 
+#include "ai_layout.h"
+#include "track.h"
+
 .text
-.global updateAIPhysicsASM
+.global updateAIPhysicsBatchASM
+.global sweepAICollisionsASM
 .global checkCollisionASM
-.global sortRidersByDistance
 
 /* Constantes */
-MAX_SPEED = 255
 MIN_SPEED = 0
-HANDLING_SCALE = 4
-ACCELERATION_DAMPING = 8
+LATERAL_SHIFT = 3
+LATERAL_LIMIT = 1 << LATERAL_SHIFT /* Déplacement latéral max par frame */
+ROAD_LEFT = 70              /* Limites de la route (avec marges) */
+ROAD_RIGHT = 250
+EDGE_PENALTY = 3            /* Pénalité de vitesse hors route */
+OVERSPEED_MARGIN = 20       /* Tolérance au-dessus de maxSpeed */
+Z_SPEED_SHIFT = 14          /* worldZ += speed << 14 */
+
+/* Distance depuis aiHot.x[i] vers les autres champs du même rider */
+OFS_SPEED = AIHOT_SPEED - AIHOT_X
+OFS_TARGETX = AIHOT_TARGETX - AIHOT_X
+OFS_MAXSPEED = AIHOT_MAXSPEED - AIHOT_X
+OFS_ACCEL = AIHOT_ACCELERATION - AIHOT_X
+OFS_HANDLING = AIHOT_HANDLING - AIHOT_X
+
+GAIN_ONE = 256              /* Gain unitaire (>> 8) */
+
+/* Collision : entité visible et dotée d'un collisionneur */
+COLLIDE_MASK = AI_FLAG_VISIBLE | ENT_FLAG_COLLIDER
 
 /*
- * Fonction: updateAIPhysicsASM
- * Met à jour la physique d'un rider IA de manière optimisée
- * Paramètres:
- *   a0 = pointeur vers AIRider
- *   d0 = targetX (position X cible)
- *   d1 = roadCurve (courbure actuelle de la route)
+ * Fonction: updateAIPhysicsBatchASM
+ * void updateAIPhysicsBatchASM(AIRiderHot* hot, const u8* live, u16 count,
+ *                              const u8* speedProfile, u16 profileLength)
+ * Intègre en un seul appel la physique des count riders de la liste des
+ * vivants (aiLive) : direction vers targetX, accélération vers la vitesse
+ * conseillée, limites de route, bornes de vitesse et avance de worldZ.
+ * Paramètres (pile, ABI m68k-elf GCC):
+ *   4(sp) = hot, 8(sp) = live, 12(sp) = count (mot bas en 14),
+ *   16(sp) = speedProfile, 20(sp) = profileLength (mot bas en 22)
+ *
+ * Virages : la vitesse visée est maxSpeed * speedProfile[worldZ >> 18] / 128
+ * (racingLineSpeed, track.c), lue à la position de chaque rider. Le profil
+ * intègre le freinage avant les virages ; l'index est borné à la dernière
+ * entrée, une position négative lit la première.
+ *
+ * Niveau de détail : chaque rider est intégré sur lodDt[i] frames écoulées
+ * (0 = pas de mise à jour cette frame, voir scheduleAILOD). Les gains
+ * (maniabilité, accélération) multipliés par dt sont plafonnés à 256 pour
+ * ne jamais dépasser la cible ; avec dt = 1 le résultat est celui d'une frame.
+ *
+ * La liste ne contient que des riders actifs : pas de test de drapeau.
+ * Pour chaque id, a1 pointe sur x[id] (les autres champs mots à un
+ * déplacement fixe) et a2 sur worldZ[id]. Offsets : ai_layout.h, vérifiés
+ * par ai_riders.c.
+ *
+ * Registres:
+ *   a0 = liste, a3 = &worldZ[0], a4 = &flags[0], a5 = &x[0], a6 = profil,
+ *   d1 = x, d2 = speed, d3 = maxSpeed, d4 = dernière entrée du profil,
+ *   d5 = dt, d7 = compteur (dbra), d0/d6 = temporaires
  */
-updateAIPhysicsASM:
-    movem.l d2-d7/a1-a2, -(sp)
-    
-    /* Chargement des données du rider */
-    move.w 0(a0), d2        /* d2 = rider->x */
-    move.w 2(a0), d3        /* d3 = rider->y */
-    move.w 14(a0), d4       /* d4 = rider->speed */
-    move.w 16(a0), d5       /* d5 = rider->maxSpeed */
-    move.w 18(a0), d6       /* d6 = rider->acceleration */
-    move.w 20(a0), d7       /* d7 = rider->handling */
-    
-    /* === CALCUL DU MOUVEMENT LATERAL === */
-    
-    /* Différence entre position actuelle et cible */
-    sub.w d2, d0            /* d0 = targetX - currentX */
-    
-    /* Application du handling (maniabilité) */
-    muls.w d7, d0           /* d0 = diff * handling */
-    asr.l #8, d0            /* d0 /= 256 (normalisation) */
-    
-    /* Limitation du mouvement latéral par frame */
-    cmp.w #8, d0
+updateAIPhysicsBatchASM:
+    movem.l d2-d7/a2-a6, -(sp)  /* 11 registres = 44 octets */
+
+    move.l 48(sp), a3           /* a3 = hot */
+    move.l 52(sp), a0           /* a0 = live */
+    move.w 58(sp), d7           /* d7 = count */
+    move.l 60(sp), a6           /* a6 = speedProfile */
+    move.w 66(sp), d4           /* d4 = profileLength */
+
+    subq.w #1, d7               /* Ajustement pour dbra */
+    bmi physics_done
+    subq.w #1, d4               /* d4 = dernière entrée */
+
+    lea AIHOT_FLAGS(a3), a4     /* a4 = &flags[0] */
+    lea AIHOT_X(a3), a5         /* a5 = &x[0] */
+    lea AIHOT_WORLDZ(a3), a3    /* a3 = &worldZ[0] */
+
+rider_loop:
+    moveq #0, d0
+    move.b (a0)+, d0            /* d0 = id */
+    moveq #0, d5
+    move.b AIHOT_LODDT-AIHOT_FLAGS(a4,d0.w), d5 /* d5 = dt */
+    beq next_rider
+
+    add.w d0, d0
+    lea 0(a5,d0.w), a1          /* a1 = &x[id] */
+    add.w d0, d0
+    lea 0(a3,d0.w), a2          /* a2 = &worldZ[id] */
+
+    move.w (a1), d1             /* d1 = x */
+    move.w OFS_SPEED(a1), d2    /* d2 = speed */
+    move.w OFS_MAXSPEED(a1), d3 /* d3 = maxSpeed */
+
+    /* === MOUVEMENT LATERAL === */
+
+    /* (targetX - x) * min(handling * dt, 256) / 256, limité à ±LATERAL_LIMIT * dt */
+    move.w OFS_HANDLING(a1), d0
+    muls.w d5, d0
+    cmp.w #GAIN_ONE, d0
+    ble.s lateral_gain_ok
+    move.w #GAIN_ONE, d0
+lateral_gain_ok:
+    move.w OFS_TARGETX(a1), d6
+    sub.w d1, d6
+    muls.w d0, d6
+    asr.l #8, d6
+    move.w d5, d0
+    lsl.w #LATERAL_SHIFT, d0    /* d0 = LATERAL_LIMIT * dt */
+    cmp.w d0, d6
     ble.s check_negative_move
-    move.w #8, d0
+    move.w d0, d6
     bra.s apply_lateral_move
-    
 check_negative_move:
-    cmp.w #-8, d0
+    neg.w d0
+    cmp.w d0, d6
     bge.s apply_lateral_move
-    move.w #-8, d0
-    
+    move.w d0, d6
 apply_lateral_move:
-    add.w d0, d2            /* Nouvelle position X */
-    
+    add.w d6, d1
+
     /* === GESTION DE LA VITESSE === */
-    
-    /* Calcul de l'accélération basée sur la différence de vitesse cible */
-    move.w d5, d1           /* d1 = maxSpeed comme vitesse cible */
-    sub.w d4, d1            /* d1 = maxSpeed - currentSpeed */
-    
-    /* Application de l'accélération */
-    muls.w d6, d1           /* d1 = speedDiff * acceleration */
-    asr.l #ACCELERATION_DAMPING, d1  /* Damping de l'accélération */
-    
-    add.w d1, d4            /* Nouvelle vitesse */
-    
-    /* === EFFETS DE LA COURBURE === */
-    
-    /* La courbure affecte la vitesse (ralentissement dans les virages) */
-    move.w d1, d2           /* d2 = roadCurve */
-    
-    /* Valeur absolue de la courbure */
-    tst.w d2
-    bpl.s curve_positive
-    neg.w d2
-curve_positive:
-    
-    /* Réduction de vitesse proportionnelle à la courbure */
-    lsr.w #2, d2            /* d2 = abs(curve) / 4 */
-    sub.w d2, d4            /* speed -= curveEffect */
-    
-    /* === CONTRAINTES DE VITESSE === */
-    
-    /* Vitesse minimale */
-    cmp.w #MIN_SPEED, d4
-    bge.s check_max_speed
-    move.w #MIN_SPEED, d4
-    
-check_max_speed:
-    /* Vitesse maximale + tolérance pour dépassements temporaires */
-    move.w d5, d1
-    add.w #20, d1           /* maxSpeed + 20 */
-    cmp.w d1, d4
-    ble.s speed_ok
-    move.w d1, d4
-    
-speed_ok:
-    
+
+    /* Vitesse visée : maxSpeed * profil[worldZ >> 18] >> 7 */
+    move.l (a2), d0
+    bpl.s profile_positive
+    moveq #0, d0                /* Derrière le départ : première entrée */
+profile_positive:
+    swap d0
+    lsr.w #RACING_LINE_SHIFT, d0
+    cmp.w d4, d0
+    bls.s profile_index_ok
+    move.w d4, d0               /* Après l'arrivée : dernière entrée */
+profile_index_ok:
+    moveq #0, d6
+    move.b 0(a6,d0.w), d6
+    mulu.w d3, d6
+    lsr.l #RACING_SPEED_SHIFT, d6
+
+    /* speed += (vitesse visée - speed) * min(accel * dt, 256) / 256 */
+    move.w OFS_ACCEL(a1), d0
+    muls.w d5, d0
+    cmp.w #GAIN_ONE, d0
+    ble.s accel_gain_ok
+    move.w #GAIN_ONE, d0
+accel_gain_ok:
+    sub.w d2, d6
+    muls.w d0, d6
+    asr.l #8, d6
+    add.w d6, d2
+
     /* === CONTRAINTES POSITION === */
-    
-    /* Limites de la route (avec marges) */
-    cmp.w #70, d2
+
+    cmp.w #ROAD_LEFT, d1
     bge.s check_right_limit
-    move.w #70, d2
-    /* Pénalité de vitesse pour sortie de route */
-    sub.w #3, d4
-    
+    moveq #ROAD_LEFT, d1
+    subq.w #EDGE_PENALTY, d2
 check_right_limit:
-    cmp.w #250, d2
-    ble.s position_ok
-    move.w #250, d2
-    /* Pénalité de vitesse */
-    sub.w #3, d4
-    
-position_ok:
-    
-    /* === SAUVEGARDE DES RESULTATS === */
-    
-    move.w d2, 0(a0)        /* rider->x = nouvelle position */
-    move.w d4, 14(a0)       /* rider->speed = nouvelle vitesse */
-    
-    movem.l (sp)+, d2-d7/a1-a2
+    cmp.w #ROAD_RIGHT, d1
+    ble.s check_min_speed
+    move.w #ROAD_RIGHT, d1
+    subq.w #EDGE_PENALTY, d2
+
+    /* === CONTRAINTES DE VITESSE === */
+
+check_min_speed:
+    tst.w d2
+    bpl.s check_max_speed
+    moveq #MIN_SPEED, d2
+check_max_speed:
+    move.w d3, d0
+    add.w #OVERSPEED_MARGIN, d0
+    cmp.w d0, d2
+    ble.s check_overspeed
+    move.w d0, d2
+check_overspeed:
+    /* Dégradation naturelle au-dessus de maxSpeed (1 par frame, sans passer dessous) */
+    cmp.w d3, d2
+    ble.s store_rider
+    sub.w d5, d2
+    cmp.w d3, d2
+    bge.s store_rider
+    move.w d3, d2
+
+store_rider:
+    move.w d1, (a1)
+    move.w d2, OFS_SPEED(a1)
+
+    /* worldZ += (speed * dt) << 14 (>= 0 : mot haut puis décalage de 2) */
+    mulu.w d5, d2
+    swap d2
+    clr.w d2
+    asr.l #16 - Z_SPEED_SHIFT, d2
+    add.l d2, (a2)
+
+next_rider:
+    dbra d7, rider_loop
+
+physics_done:
+    movem.l (sp)+, d2-d7/a2-a6
+    rts
+
+/*
+ * Fonction: sweepAICollisionsASM
+ * u16 sweepAICollisionsASM(const AIRiderHot* hot, const u8* order, u16 count,
+ *                          AIContact* contacts, u16 maxContacts)
+ * Broadphase par balayage de l'ordre de course (trié par worldZ décroissant) :
+ * chaque rider visible n'est comparé qu'aux suivants tant que l'écart en Z
+ * reste sous AI_COLLIDE_Z, puis test de boîte sur X. Les paires en contact
+ * sont écrites dans contacts (2 octets : a, b) ; retourne leur nombre.
+ * Paramètres (pile, ABI m68k-elf GCC):
+ *   4(sp) = hot, 8(sp) = order, 12(sp) = count (mot bas en 14),
+ *   16(sp) = contacts, 20(sp) = maxContacts (mot bas en 22)
+ *
+ * Les tableaux dépassant la portée d'un déplacement 8 bits, chaque champ a
+ * son propre registre de base et est indexé par l'id du rider (An,Dn.w).
+ *
+ * Registres:
+ *   a0 = &worldZ[0], a4 = &x[0], a5 = &flags[0]
+ *   a1 = ordre (boucle externe), a2 = ordre (boucle interne), a3 = sortie
+ *   d3 = places restantes, d4 = x du rider courant, d5 = worldZ du rider courant
+ *   d6/d7 = compteurs (dbra), d0-d2 = temporaires
+ */
+sweepAICollisionsASM:
+    movem.l d2-d7/a2-a5, -(sp)  /* 10 registres = 40 octets */
+
+    move.l 44(sp), a0           /* a0 = hot = &worldZ[0] */
+    lea AIHOT_X(a0), a4         /* a4 = &x[0] */
+    lea AIHOT_FLAGS(a0), a5     /* a5 = &flags[0] */
+    move.l 48(sp), a1           /* a1 = order */
+    move.w 54(sp), d7           /* d7 = count */
+    move.l 56(sp), a3           /* a3 = contacts */
+    move.w 62(sp), d3           /* d3 = maxContacts */
+    beq.s sweep_done
+
+    /* Au moins deux riders pour former une paire */
+    subq.w #2, d7
+    bmi.s sweep_done
+
+sweep_outer:
+    moveq #0, d2
+    move.b (a1)+, d2            /* d2 = id du rider courant */
+    move.b (a5,d2.w), d0
+    not.b d0
+    and.b #COLLIDE_MASK, d0     /* 0 si visible et collisionneur */
+    bne.s sweep_next_outer
+
+    add.w d2, d2
+    move.w (a4,d2.w), d4        /* d4 = x[id] */
+    add.w d2, d2
+    move.l (a0,d2.w), d5        /* d5 = worldZ[id] */
+
+    move.l a1, a2               /* Riders suivants dans l'ordre */
+    move.w d7, d6               /* d6 = nombre de suivants - 1 */
+
+sweep_inner:
+    moveq #0, d1
+    move.b (a2)+, d1            /* d1 = id du voisin */
+
+    /* Écart en Z (>= 0, l'ordre est décroissant) : fin de fenêtre ? */
+    move.w d1, d0
+    lsl.w #2, d0
+    move.l d5, d2
+    sub.l (a0,d0.w), d2
+    cmp.l #AI_COLLIDE_Z, d2
+    bge.s sweep_next_outer      /* Les suivants sont encore plus loin */
+
+    move.b (a5,d1.w), d2
+    not.b d2
+    and.b #COLLIDE_MASK, d2
+    bne.s sweep_next_inner
+
+    /* Boîte sur X : abs(x1 - x2) < AI_COLLIDE_X */
+    lsr.w #1, d0
+    move.w d4, d2
+    sub.w (a4,d0.w), d2
+    bpl.s sweep_dx_positive
+    neg.w d2
+sweep_dx_positive:
+    cmp.w #AI_COLLIDE_X, d2
+    bge.s sweep_next_inner
+
+    /* Contact : paire (courant, voisin) */
+    move.b -1(a1), (a3)+
+    move.b d1, (a3)+
+    subq.w #1, d3
+    beq.s sweep_done            /* Liste pleine */
+
+sweep_next_inner:
+    dbra d6, sweep_inner
+
+sweep_next_outer:
+    dbra d7, sweep_outer
+
+sweep_done:
+    /* Nombre de paires = octets écrits / 2 */
+    move.l a3, d0
+    sub.l 56(sp), d0
+    lsr.w #1, d0
+    movem.l (sp)+, d2-d7/a2-a5
     rts
 
 /*
  * Fonction: checkCollisionASM
- * Vérifie la collision entre deux points avec un seuil
- * Paramètres:
- *   d0 = x1, d1 = y1 (premier point)
- *   d2 = x2, d3 = y2 (second point)  
- *   d4 = threshold (seuil de collision)
+ * bool checkCollisionASM(s16 x1, s16 y1, s16 x2, s16 y2, s16 threshold)
+ * Vérifie la collision entre deux points : abs(x1 - x2) < threshold
+ * et abs(y1 - y2) < threshold
+ * Paramètres (pile, ABI m68k-elf GCC, mots bas en 6/10/14/18/22):
+ *   4(sp) = x1, 8(sp) = y1, 12(sp) = x2, 16(sp) = y2, 20(sp) = threshold
  * Retour:
  *   d0 = 1 si collision, 0 sinon
  */
 checkCollisionASM:
-    movem.l d5-d6, -(sp)
-    
-    /* Calcul de la distance en X */
-    sub.w d2, d0            /* d0 = x1 - x2 */
-    
-    /* Valeur absolue */
-    tst.w d0
-    bpl.s no_collision
+    move.w 22(sp), d1           /* d1 = threshold */
+
+    /* Distance en X */
+    move.w 6(sp), d0
+    sub.w 14(sp), d0            /* d0 = x1 - x2 */
+    bpl.s collision_dx_positive
     neg.w d0
-    
-    /* Calcul de la distance en Y */
-    sub.w d3, d1            /* d1 = y1 - y2 */
-    
-    /* Valeur absolue */
-    tst.w d1
-    bpl.s no_collision
-    neg.w d1
-    
-    /* Vérification de la collision par rapport au seuil */
-    cmp.w d4, d0
-    ble.s no_collision
-    cmp.w d4, d1
-    ble.s no_collision
-    
+collision_dx_positive:
+    cmp.w d1, d0
+    bge.s no_collision
+
+    /* Distance en Y */
+    move.w 10(sp), d0
+    sub.w 18(sp), d0            /* d0 = y1 - y2 */
+    bpl.s collision_dy_positive
+    neg.w d0
+collision_dy_positive:
+    cmp.w d1, d0
+    bge.s no_collision
+
     /* Collision détectée */
-    move.w #1, d0
-    bra.s end_check_collision
-    
-no_collision:
-    /* Pas de collision */
-    move.w #0, d0
-    
-end_check_collision:
-    movem.l (sp)+, d5-d6
+    moveq #1, d0
     rts
 
-/*
- * Fonction: sortRidersByDistance
- * Trie les riders par distance à la cible (X) - Méthode de tri simple
- * Paramètres:
- *   a0 = pointeur vers le début de la liste des riders
- *   d0 = nombre de riders à trier
- */
-sortRidersByDistance:
-    movem.l d1-d7/a1-a2, -(sp)
-    
-    /* Vérification du nombre de riders */
-    cmp.w #2, d0
-    blt.s end_sort
-    
-    /* Initialisation */
-    move.w (a0), d1         /* d1 = première distance */
-    move.w #1, d2           /* d2 = index du rider courant */
-    move.w d0, d3           /* d3 = nombre de riders restants */
-    
-tri_riders:
-    /* Chargement des distances */
-    move.w (a0, d2.w), d4   /* d4 = distance du rider courant */
-    
-    /* Comparaison avec la distance de référence */
-    cmp.w d1, d4
-    blt.s rider_plus_loin
-    
-    /* Échange des riders */
-    move.w (a0), d0         /* d0 = première distance */
-    move.w d4, (a0)         /* première distance = distance du rider courant */
-    move.w d0, (a0, d2.w)   /* distance du rider courant = première distance */
-    move.w d4, d1           /* d1 = nouvelle distance de référence */
-    
-rider_plus_loin:
-    /* Rider suivant */
-    add.w #2, d2            /* d2++ (prochain rider) */
-    sub.w #1, d3            /* d3-- (un rider de moins à trier) */
-    cmp.w #1, d3
-    bge.s tri_riders
-    
-end_sort:
-    movem.l (sp)+, d1-d7/a1-a2
-    rts
\ No newline at end of file
+no_collision:
+    moveq #0, d0
+    rts
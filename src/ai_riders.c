@@ -1,349 +1,231 @@
 #include <genesis.h>
 #include "resources.h"
 #include "ai_riders.h"
+#include "fast_random.h"
+#include "track.h"
+#include "ai_lanes.h"
+#include "road.h"
+#include "entity.h"
+#include "sprites.h"
+#include "rider_frames.h"
+#include "scenery.h"
+#include "ai_field.h"
+#include "text_buffer.h"
 
-// Configuration globale IA
-#define AI_DECISION_INTERVAL 30    // Frames entre décisions
-#define AI_SIGHT_DISTANCE 200      // Distance de "vue" de l'IA
-#define AI_ATTACK_RANGE 32         // Portée d'attaque
-#define RUBBER_BAND_DISTANCE 400   // Distance max rubber band
+// Niveau de détail : bandes de distance au joueur (unités) et période associée
+#define AI_LOD_NEAR (150L << 16)   // En deçà : chaque frame
+#define AI_LOD_MID  (300L << 16)   // En deçà : une frame sur 2
+#define AI_LOD_FAR  (500L << 16)   // En deçà : une frame sur 4, au-delà sur 8
+#define AI_LOD_MAX_DT 8            // Frames intégrées au plus en une mise à jour
+
+// Vérification à la compilation des offsets partagés avec ai_physics.s
+#define AI_LAYOUT_CHECK(field, offset) \
+    _Static_assert(__builtin_offsetof(AIRiderHot, field) == (offset), \
+                   "ai_layout.h: " #offset " ne correspond pas a AIRiderHot")
+
+AI_LAYOUT_CHECK(worldZ, AIHOT_WORLDZ);
+AI_LAYOUT_CHECK(x, AIHOT_X);
+AI_LAYOUT_CHECK(y, AIHOT_Y);
+AI_LAYOUT_CHECK(speed, AIHOT_SPEED);
+AI_LAYOUT_CHECK(targetX, AIHOT_TARGETX);
+AI_LAYOUT_CHECK(maxSpeed, AIHOT_MAXSPEED);
+AI_LAYOUT_CHECK(acceleration, AIHOT_ACCELERATION);
+AI_LAYOUT_CHECK(handling, AIHOT_HANDLING);
+AI_LAYOUT_CHECK(flags, AIHOT_FLAGS);
+AI_LAYOUT_CHECK(lodDt, AIHOT_LODDT);
+_Static_assert(sizeof(AIRiderHot) == AIHOT_SIZE, "ai_layout.h: AIHOT_SIZE");
 
 // Variables globales
-AIRider aiRiders[MAX_AI_RIDERS];
-u8 activeRiders = 0;
-
-// Tables de personnalité pré-calculées
-const s16 aiPersonalities[5][6] = {
-    // maxSpeed, accel, handling, rubber, aggression, attackFreq
-    { 240, 4, 180, 50,  200, 120 },  // AGGRESSIVE
-    { 200, 3, 220, 80,  80,  180 },  // DEFENSIVE  
-    { 220, 5, 140, 30,  150, 90 },   // ERRATIC
-    { 210, 3, 200, 180, 100, 150 },  // RUBBER_BAND
-    { 180, 2, 160, 60,  250, 60 }    // BLOCKER
-};
+AIRiderHot aiHot;                  // Données chaudes (tableaux parallèles)
+AIRider aiRiders[MAX_AI_RIDERS];   // Données froides
+u8 activeRiders = 0;               // Nombre de riders vivants
+
+// Pool de riders : liste dense des vivants (itération) et liste chaînée des
+// emplacements libres, chaînée dans aiRiders[].poolLink (O(1) dans les deux sens)
+u8 aiLive[MAX_AI_RIDERS];
+static u8 aiFreeHead = AI_NO_RIDER;
+
+// Ordre de course : riders actifs triés par worldZ décroissant (leader en tête).
+// Maintenu chaque frame par une passe d'insertion, quasi gratuite car l'ordre
+// change rarement d'une frame à l'autre. Un retrait met le dernier à la place
+// du rider retiré (aiOrderDirty) : la passe suivante le remet en place.
+u8 aiOrder[MAX_AI_RIDERS];
+u8 aiOrderCount = 0;
+bool aiOrderDirty = FALSE;
+
+// Paires en contact de la frame (remplies par checkAICollisions)
+AIContact aiContacts[AI_MAX_CONTACTS];
+u8 aiContactCount = 0;
+
+// Compteur de frames du niveau de détail et riders mis à jour cette frame
+static u8 aiLodFrame = 0;
+u8 aiLodUpdates = 0;
+u8 aiDecisionCount = 0;            // Décisions prises cette frame
 
 // === INITIALISATION ET GESTION ===
 
 void initAISystem(void) {
     u8 i;
     
-    // Reset de tous les riders
+    // Reset de tous les riders, tous les emplacements dans la liste libre
     for (i = 0; i < MAX_AI_RIDERS; i++) {
-        aiRiders[i].active = FALSE;
-        aiRiders[i].visible = FALSE;
-        aiRiders[i].spriteIndex = 0xFF; // Non assigné
+        aiHot.flags[i] = 0;
+        aiRiders[i].spriteIndex = SPRITE_NONE; // Non assigné
+        aiRiders[i].frameSlot = RIDER_FRAME_NONE;
+        aiRiders[i].generation = 0;
+        aiRiders[i].poolLink = (i + 1 < MAX_AI_RIDERS) ? i + 1 : AI_NO_RIDER;
     }
+    aiFreeHead = 0;
+    
+    initAIDecisions();
+    initRiderFrames();
     
     activeRiders = 0;
+    aiOrderCount = 0;
     
-    VDP_drawText("AI SYSTEM READY", 1, 1);
+    drawTimedText("AI SYSTEM READY", 1, 4, 120);
 }
 
-void spawnAIRider(AIType type, s32 worldZ, s16 laneX) {
-    if (activeRiders >= MAX_AI_RIDERS) return;
+// Emplacement commun à toutes les entités : pool, transform, niveau de
+// détail et ordre de course. Le mouvement est configuré par l'appelant.
+u8 allocEntity(u8 kind, s32 worldZ, s16 x) {
+    u8 id = aiFreeHead;
     
-    u8 index = activeRiders;
-    AIRider* rider = &aiRiders[index];
+    if (id == AI_NO_RIDER) return AI_NO_RIDER;
     
-    // Configuration de base
-    rider->worldX = (s32)laneX << 16;
-    rider->worldZ = worldZ;
-    rider->x = laneX;
-    rider->y = 120; // Position Y de base
+    AIRider* rider = &aiRiders[id];
     
-    // Personnalité basée sur le type
-    rider->aiType = type;
-    rider->maxSpeed = aiPersonalities[type][0];
-    rider->acceleration = aiPersonalities[type][1];
-    rider->handling = aiPersonalities[type][2];
-    rider->rubberBandStrength = aiPersonalities[type][3];
-    rider->aggressionLevel = aiPersonalities[type][4];
+    // Sortie de la liste libre, ajout en fin de liste des vivants
+    aiFreeHead = rider->poolLink;
+    rider->poolLink = activeRiders;
+    aiLive[activeRiders++] = id;
     
-    // État initial
+    // Configuration de base
+    rider->kind = kind;
+    aiHot.worldZ[id] = worldZ;
+    aiHot.x[id] = x;
+    aiHot.y[id] = 120; // Position Y de base
+    
+    // État neutre du bloc froid (lu aussi par les systèmes non IA)
     rider->state = AI_STATE_RACING;
-    rider->speed = rider->maxSpeed >> 1; // Démarre à mi-vitesse
     rider->stateTimer = 0;
-    rider->decisionTimer = random() % AI_DECISION_INTERVAL;
-    rider->targetX = laneX;
-    
-    // Combat
     rider->health = 100;
     rider->attackTimer = 0;
-    rider->canAttack = TRUE;
+    rider->canAttack = FALSE;
     
     // Animation
     rider->animFrame = 0;
     rider->animTimer = 0;
     
-    // Activation
-    rider->active = TRUE;
-    rider->visible = FALSE; // Sera activé par le culling
+    // Niveau de détail : mis à jour dès la prochaine frame avec dt = 1
+    rider->lodShift = 0;
+    rider->lodLastFrame = aiLodFrame;
+    aiHot.lodDt[id] = 0;
     
-    activeRiders++;
-}
-
-// === IA DECISION MAKING ===
-
-void updateAIDecisions(AIRider* rider) {
-    if (rider->decisionTimer > 0) {
-        rider->decisionTimer--;
-        return;
-    }
+    // Activation et composants du type (visibilité activée par le culling)
+    aiHot.flags[id] = AI_FLAG_ACTIVE | entityKinds[kind].components;
     
-    // Reset du timer de décision
-    rider->decisionTimer = AI_DECISION_INTERVAL + (random() % 20) - 10;
+    // Hors peloton par défaut (promoteFieldEntry le rattache)
+    rider->fieldIndex = AI_NO_RIDER;
     
-    // Calcul de la distance au joueur
-    s16 playerDist = abs(rider->x - playerX);
-    rider->playerDistance = playerDist;
+    // Ajout en queue de l'ordre de course, remis en place par updateRiderOrder
+    rider->orderIndex = aiOrderCount;
+    aiOrder[aiOrderCount++] = id;
     
-    // Machine à états simplifiée
-    switch (rider->state) {
-        case AI_STATE_RACING:
-            updateRacingAI(rider);
-            break;
-            
-        case AI_STATE_ATTACKING:
-            updateAttackingAI(rider);
-            break;
-            
-        case AI_STATE_AVOIDING:
-            updateAvoidingAI(rider);
-            break;
-            
-        case AI_STATE_CRASHED:
-            updateCrashedAI(rider);
-            break;
-            
-        case AI_STATE_CATCHING_UP:
-            updateCatchingUpAI(rider);
-            break;
-    }
+    return id;
 }
 
-void updateRacingAI(AIRider* rider) {
-    s16 laneCenter;
-    s16 avoidanceX;
-    
-    switch (rider->aiType) {
-        case AI_AGGRESSIVE:
-            // Fonce vers le joueur ou la ligne droite
-            if (rider->playerDistance < AI_SIGHT_DISTANCE && rider->aggressionLevel > 150) {
-                rider->targetX = playerX + ((random() % 40) - 20);
-                if (rider->playerDistance < AI_ATTACK_RANGE) {
-                    rider->state = AI_STATE_ATTACKING;
-                    rider->stateTimer = 60; // 1 seconde d'attaque
-                }
-            } else {
-                rider->targetX = 160 + ((random() % 80) - 40); // Centre ±40
-            }
-            break;
-            
-        case AI_DEFENSIVE:
-            // Évite le joueur et les autres riders
-            laneCenter = 160;
-            avoidanceX = 0;
-            
-            // Évitement du joueur
-            if (rider->playerDistance < 80) {
-                avoidanceX = (rider->x < playerX) ? -60 : 60;
-            }
-            
-            rider->targetX = laneCenter + avoidanceX;
-            
-            // Changement d'état si trop proche
-            if (rider->playerDistance < 40) {
-                rider->state = AI_STATE_AVOIDING;
-                rider->stateTimer = 90;
-            }
-            break;
-            
-        case AI_ERRATIC:
-            // Comportement chaotique
-            if ((random() % 100) < 30) { // 30% de chance de changer
-                rider->targetX = 100 + random() % 120; // Entre 100-220
-            }
-            
-            // Attaque occasionnelle
-            if (rider->playerDistance < 60 && (random() % 100) < 25) {
-                rider->state = AI_STATE_ATTACKING;
-                rider->stateTimer = 30;
-            }
-            break;
-            
-        case AI_RUBBER_BAND:
-            updateRubberBandAI(rider);
-            break;
-            
-        case AI_BLOCKER:
-            // Essaie de bloquer le joueur
-            rider->targetX = playerX + ((random() % 20) - 10);
-            
-            // Ralentit si devant le joueur
-            if (rider->worldZ > (s32)(trackPosition << 16)) {
-                rider->speed = min(rider->speed, playerSpeed + 1);
-            }
-            break;
-    }
+u8 spawnAIRider(AIType type, s32 worldZ, s16 laneX) {
+    u8 id = allocEntity(ENTITY_RIDER, worldZ, laneX);
     
-    // Contraintes de la route
-    if (rider->targetX < 80) rider->targetX = 80;
-    if (rider->targetX > 240) rider->targetX = 240;
-}
-
-void updateRubberBandAI(AIRider* rider) {
-    s32 playerWorldZ = trackPosition << 16;
-    s32 distanceToPlayer = rider->worldZ - playerWorldZ;
-    
-    // Rubber band - ajuste la vitesse selon la distance
-    if (distanceToPlayer > (RUBBER_BAND_DISTANCE << 16)) {
-        // Trop loin derrière - accélère
-        rider->state = AI_STATE_CATCHING_UP;
-        rider->stateTimer = 120;
-        rider->speed = min(rider->maxSpeed + 20, 255);
-    } else if (distanceToPlayer < -(RUBBER_BAND_DISTANCE << 16)) {
-        // Trop loin devant - ralentit
-        rider->speed = max(rider->speed - 2, rider->maxSpeed >> 2);
-    } else {
-        // Distance correcte - vitesse normale
-        rider->speed = rider->maxSpeed;
-    }
+    if (id == AI_NO_RIDER) return AI_NO_RIDER;
     
-    // Position cible normale
-    rider->targetX = 160 + ((random() % 60) - 30);
-}
-
-void updateAttackingAI(AIRider* rider) {
-    // Fonce vers le joueur
-    rider->targetX = playerX;
-    rider->speed = min(rider->speed + 2, rider->maxSpeed + 10);
+    AIRider* rider = &aiRiders[id];
     
-    // Vérification de collision pour attaque
-    if (rider->playerDistance < AI_ATTACK_RANGE && rider->canAttack) {
-        performAIAttack(rider);
-    }
-    
-    // Timeout de l'attaque
-    if (rider->stateTimer > 0) {
-        rider->stateTimer--;
-    } else {
-        rider->state = AI_STATE_RACING;
-        rider->attackTimer = 180; // Cooldown 3 secondes
-    }
-}
-
-void updateAvoidingAI(AIRider* rider) {
-    // Mouvement d'évitement
-    s16 avoidDir = (rider->x < playerX) ? -1 : 1;
-    rider->targetX = rider->x + (avoidDir * 80);
-    
-    // Ralentit légèrement
-    rider->speed = max(rider->speed - 1, rider->maxSpeed >> 2);
+    // Personnalité basée sur le type (ai_behavior.c)
+    const AIParams* p = &aiParams[type];
+    rider->aiType = type;
+    aiHot.maxSpeed[id] = p->maxSpeed;
+    aiHot.acceleration[id] = p->acceleration;
+    aiHot.handling[id] = p->handling;
+    rider->rubberBandStrength = p->rubberBandStrength;
+    rider->aggressionLevel = p->aggression;
     
-    if (rider->stateTimer > 0) {
-        rider->stateTimer--;
-    } else {
-        rider->state = AI_STATE_RACING;
-    }
-}
-
-void updateCrashedAI(AIRider* rider) {
-    // Récupération après crash
-    rider->speed = 0;
-    rider->targetX = rider->x; // Reste sur place
+    // État initial
+    aiHot.speed[id] = aiHot.maxSpeed[id] >> 1; // Démarre à mi-vitesse
+    aiHot.targetX[id] = laneX;
+    rider->canAttack = TRUE;
     
-    if (rider->stateTimer > 0) {
-        rider->stateTimer--;
-    } else {
-        rider->state = AI_STATE_RACING;
-        rider->speed = rider->maxSpeed >> 2; // Redémarre lentement
-        rider->health = min(rider->health + 20, 100);
-    }
-}
-
-void updateCatchingUpAI(AIRider* rider) {
-    // Mode rattrapage accéléré
-    rider->speed = min(rider->maxSpeed + 30, 255);
-    rider->targetX = 160; // Ligne droite pour rattraper
+    // Place dans le tour de décisions
+    assignDecisionSlot(id);
     
-    if (rider->stateTimer > 0) {
-        rider->stateTimer--;
-    } else {
-        rider->state = AI_STATE_RACING;
-    }
+    return id;
 }
 
 // === COMBAT ET INTERACTIONS ===
 
-void performAIAttack(AIRider* rider) {
+void performAIAttack(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    const AIParams* p = &aiParams[rider->aiType];
+    
     if (rider->attackTimer > 0) return;
     
-    // Logique d'attaque selon le type
-    switch (rider->aiType) {
-        case AI_AGGRESSIVE:
-        case AI_BLOCKER:
-            // Coup de poing/kick
-            if (checkCollisionASM(rider->x, rider->y, playerX, 190, 24)) {
-                // Impact sur le joueur
-                playerSpeed = max(playerSpeed - 15, 0);
-                // Effect visuel/sonore ici
-                VDP_drawText("HIT!", 15, 10);
-            }
-            break;
-            
-        case AI_ERRATIC:
-            // Attaque chaotique - peut rater
-            if ((random() % 100) < 70) { // 70% de réussite
-                if (checkCollisionASM(rider->x, rider->y, playerX, 190, 28)) {
-                    playerSpeed = max(playerSpeed - 10, 0);
-                }
-            }
-            break;
-            
-        default:
-            // Autres types attaquent moins fort
-            if (checkCollisionASM(rider->x, rider->y, playerX, 190, 20)) {
-                playerSpeed = max(playerSpeed - 5, 0);
-            }
-            break;
+    // Coup porté selon la précision du type, puis test de portée
+    if (randomChance(RANDOM_STREAM_AI, p->hitChance) &&
+        checkCollisionASM(aiHot.x[id], aiHot.y[id], playerX, 190, p->hitRange)) {
+        // Impact sur le joueur
+        playerSpeed = max(playerSpeed - p->hitDamage, 0);
+        // Effect visuel/sonore ici
+        drawTimedText("HIT!", 15, 10, 30);
     }
     
     rider->canAttack = FALSE;
-    rider->attackTimer = 120 + (random() % 60); // Cooldown variable
+    rider->attackTimer = p->hitCooldown + randomRangeASM(RANDOM_STREAM_AI, 60); // Cooldown variable
 }
 
 void checkAICollisions(void) {
-    u8 i, j;
+    s32 playerWorldZ = trackPosition << 16;
+    u8 n;
     
-    // Collisions entre IA
-    for (i = 0; i < activeRiders; i++) {
-        if (!aiRiders[i].active || !aiRiders[i].visible) continue;
+    // Paires d'entités à collisionneur : balayage de l'ordre de course
+    // (voisins en Z uniquement)
+    aiContactCount = sweepAICollisionsASM(&aiHot, aiOrder, aiOrderCount,
+                                          aiContacts, AI_MAX_CONTACTS);
+    
+    // Joueur : entités de l'ordre dans sa fenêtre Z
+    n = findOrderIndexForZ(playerWorldZ + AI_COLLIDE_Z - 1);
+    
+    for (; n < aiOrderCount && aiContactCount < AI_MAX_CONTACTS; n++) {
+        u8 i = aiOrder[n];
         
-        // Collision avec le joueur
-        if (checkCollisionASM(aiRiders[i].x, aiRiders[i].y, playerX, 190, 20)) {
-            handlePlayerAICollision(&aiRiders[i]);
-        }
+        if (aiHot.worldZ[i] <= playerWorldZ - AI_COLLIDE_Z) break;
+        if ((aiHot.flags[i] & (AI_FLAG_VISIBLE | ENT_FLAG_COLLIDER)) !=
+            (AI_FLAG_VISIBLE | ENT_FLAG_COLLIDER)) continue;
         
-        // Collisions entre IA
-        for (j = i + 1; j < activeRiders; j++) {
-            if (!aiRiders[j].active || !aiRiders[j].visible) continue;
-            
-            if (checkCollisionASM(aiRiders[i].x, aiRiders[i].y, 
-                                aiRiders[j].x, aiRiders[j].y, 18)) {
-                handleAICollision(&aiRiders[i], &aiRiders[j]);
-            }
+        if (checkCollisionASM(aiHot.x[i], aiHot.worldZ[i] >> 16,
+                              playerX, trackPosition, AI_COLLIDE_X)) {
+            aiContacts[aiContactCount].a = i;
+            aiContacts[aiContactCount].b = AI_CONTACT_PLAYER;
+            aiContactCount++;
         }
     }
+    
+    // Réponse aux contacts selon les types en présence (entity.c)
+    for (n = 0; n < aiContactCount; n++) {
+        resolveEntityContact(aiContacts[n].a, aiContacts[n].b);
+    }
 }
 
-void handlePlayerAICollision(AIRider* rider) {
+void handlePlayerAICollision(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    
     // Effets de la collision
-    s16 impactForce = (rider->speed + playerSpeed) >> 3;
+    s16 impactForce = (aiHot.speed[id] + playerSpeed) >> 3;
     
     // Impact sur le joueur
-    if (playerSpeed > rider->speed) {
+    if (playerSpeed > aiHot.speed[id]) {
         // Joueur plus rapide - pousse l'IA
-        rider->speed = max(rider->speed - impactForce, 0);
+        aiHot.speed[id] = max(aiHot.speed[id] - impactForce, 0);
         rider->state = AI_STATE_CRASHED;
         rider->stateTimer = 60;
         rider->health -= 15;
@@ -351,157 +233,203 @@ void handlePlayerAICollision(AIRider* rider) {
         // IA plus rapide - impacte le joueur  
         playerSpeed = max(playerSpeed - (impactForce >> 1), 0);
         // Décalage latéral du joueur
-        playerX += (rider->x > playerX) ? -10 : 10;
+        playerX += (aiHot.x[id] > playerX) ? -10 : 10;
     }
     
-    // Vérification KO de l'IA
+    // Vérification KO de l'IA, sinon réaction immédiate au choc
     if (rider->health <= 0) {
-        disableAIRider(rider);
+        disableAIRider(id);
+    } else {
+        requestUrgentDecision(id, AI_URGENT_HIT);
     }
 }
 
-void handleAICollision(AIRider* rider1, AIRider* rider2) {
+void handleAICollision(u8 id1, u8 id2) {
     // Collision entre deux IA - échange de vitesse partiel
-    s16 speed1 = rider1->speed;
-    s16 speed2 = rider2->speed;
+    s16 speed1 = aiHot.speed[id1];
+    s16 speed2 = aiHot.speed[id2];
     
-    rider1->speed = (speed1 + speed2) >> 1;
-    rider2->speed = (speed1 + speed2) >> 1;
+    aiHot.speed[id1] = (speed1 + speed2) >> 1;
+    aiHot.speed[id2] = (speed1 + speed2) >> 1;
     
     // Les deux passent en évitement
-    rider1->state = AI_STATE_AVOIDING;
-    rider1->stateTimer = 45;
+    aiRiders[id1].state = AI_STATE_AVOIDING;
+    aiRiders[id1].stateTimer = 45;
+    
+    aiRiders[id2].state = AI_STATE_AVOIDING;  
+    aiRiders[id2].stateTimer = 45;
     
-    rider2->state = AI_STATE_AVOIDING;  
-    rider2->stateTimer = 45;
+    requestUrgentDecision(id1, AI_URGENT_COLLISION);
+    requestUrgentDecision(id2, AI_URGENT_COLLISION);
 }
 
 // === PHYSIQUE ET MOUVEMENT ===
 
-void updateAIPhysics(AIRider* rider, s16 roadCurve) {
-    // Appel de la routine assembleur optimisée
-    updateAIPhysicsASM(rider, rider->targetX, roadCurve);
-    
-    // Mise à jour position monde
-    rider->worldZ += (s32)rider->speed << 14; // Conversion vitesse -> mouvement
-    
-    // Contraintes physiques
-    if (rider->x < 60) {
-        rider->x = 60;
-        rider->speed = max(rider->speed - 5, 0); // Pénalité bord route
-    }
-    if (rider->x > 260) {
-        rider->x = 260;
-        rider->speed = max(rider->speed - 5, 0);
-    }
+void updateAIPhysics(void) {
+    u8 i;
     
-    // Dégradation naturelle de la vitesse
-    if (rider->speed > rider->maxSpeed) {
-        rider->speed = max(rider->speed - 1, rider->maxSpeed);
-    }
+    // Direction, vitesse, limites et avance de worldZ de tous les riders
+    // en un seul appel assembleur (ai_physics.s), vitesse visée lue dans le
+    // profil de la piste à la position de chacun
+    updateAIPhysicsBatchASM(&aiHot, aiLive, activeRiders, racingLineSpeed, racingLineLength);
     
-    // Mise à jour des timers
-    if (rider->attackTimer > 0) rider->attackTimer--;
-    if (!rider->canAttack && rider->attackTimer == 0) {
-        rider->canAttack = TRUE;
+    // Mise à jour des timers de combat (données froides, rarement non nuls)
+    for (i = 0; i < activeRiders; i++) {
+        AIRider* rider = &aiRiders[aiLive[i]];
+        u8 dt = aiHot.lodDt[aiLive[i]];
+        
+        if (dt == 0 || !(aiHot.flags[aiLive[i]] & ENT_FLAG_AI)) continue;
+        
+        rider->attackTimer = (rider->attackTimer > dt) ? rider->attackTimer - dt : 0;
+        if (!rider->canAttack && rider->attackTimer == 0) {
+            rider->canAttack = TRUE;
+        }
     }
 }
 
 // === RENDU ET CULLING ===
 
 void updateAIVisibility(void) {
-    u8 i;
+    u8 n;
     s32 playerWorldZ = trackPosition << 16;
     
-    for (i = 0; i < activeRiders; i++) {
-        if (!aiRiders[i].active) continue;
-        
-        // Culling par distance
-        s32 distance = abs(aiRiders[i].worldZ - playerWorldZ);
-        bool wasVisible = aiRiders[i].visible;
+    // Parcours de l'ordre de course : uniquement les riders actifs
+    for (n = 0; n < aiOrderCount; n++) {
+        u8 i = aiOrder[n];
+        u8 flags = aiHot.flags[i];
         
-        aiRiders[i].visible = (distance < (500 << 16)); // 500 unités max
+        // Culling par distance (500 unités max)
+        s32 distance = abs(aiHot.worldZ[i] - playerWorldZ);
+        bool wasVisible = (flags & AI_FLAG_VISIBLE) != 0;
+        bool visible = (distance < (500 << 16));
         
         // Activation/désactivation du sprite
-        if (aiRiders[i].visible && !wasVisible) {
-            assignSpriteToAI(&aiRiders[i]);
-        } else if (!aiRiders[i].visible && wasVisible) {
-            releaseSpriteFromAI(&aiRiders[i]);
+        if (visible && !wasVisible) {
+            aiHot.flags[i] = flags | AI_FLAG_VISIBLE;
+            assignSpriteToAI(i);
+        } else if (!visible && wasVisible) {
+            aiHot.flags[i] = flags & ~AI_FLAG_VISIBLE;
+            releaseSpriteFromAI(i);
         }
     }
 }
 
-void assignSpriteToAI(AIRider* rider) {
-    if (rider->spriteIndex != 0xFF) return; // Déjà assigné
-    
-    // Configuration du sprite selon le type d'IA
-    u16 tileAttr = TILE_ATTR(PAL1, 0, FALSE, FALSE);
-    
-    /* DEBUG_DISABLE_SPRITE_AI - sprite_ai_bike désactivé pour éviter artéfacts VRAM
-    Sprite* sprite = SPR_addSprite(&sprite_ai_bike, rider->x - 8, rider->y - 8, tileAttr);
-    
-    if (sprite != NULL) {
-        // Stockage du pointeur sprite converti en index pour simplification
-        rider->spriteIndex = (u8)((u32)sprite & 0xFF);
-    } else {
-        rider->spriteIndex = 0xFF; // Pas de sprite disponible
+void assignSpriteToAI(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    
+    if (rider->spriteIndex != SPRITE_NONE) return; // Déjà assigné
+    
+    // Emplacement du gestionnaire de sprites et, pour un rider, zone de
+    // frames en VRAM (les autres types lisent la banque des objets de
+    // route), placés par renderAIRiders ; faute de l'un ou l'autre,
+    // l'entité reste simulée sans sprite
+    if (entityKinds[rider->kind].frames == ENTITY_RIDER_FRAMES) {
+        rider->frameSlot = allocRiderFrameSlot();
+        if (rider->frameSlot == RIDER_FRAME_NONE) return;
     }
-    DEBUG_DISABLE_SPRITE_AI */
     
-    // Temporairement pas de sprite pour les AI (éviter erreur compilation)
-    rider->spriteIndex = 0xFF;
+    rider->spriteIndex = allocSpriteSlot();
+    if (rider->spriteIndex == SPRITE_NONE) {
+        freeRiderFrameSlot(rider->frameSlot);
+        rider->frameSlot = RIDER_FRAME_NONE;
+    }
 }
 
-void releaseSpriteFromAI(AIRider* rider) {
-    if (rider->spriteIndex != 0xFF) {
-        // Pour SGDK, nous devons passer NULL pour libérer tous les sprites
-        // ou gérer manuellement les sprites individuels
-        rider->spriteIndex = 0xFF;
+void releaseSpriteFromAI(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    
+    if (rider->spriteIndex != SPRITE_NONE) {
+        freeSpriteSlot(rider->spriteIndex);
+        freeRiderFrameSlot(rider->frameSlot);
+        rider->spriteIndex = SPRITE_NONE;
+        rider->frameSlot = RIDER_FRAME_NONE;
     }
 }
 
 void renderAIRiders(void) {
-    u8 i;
+    s32 playerWorldZ = trackPosition << 16;
+    u16 s = 0;
+    u8 n;
     
-    for (i = 0; i < activeRiders; i++) {
-        if (!aiRiders[i].active || !aiRiders[i].visible) continue;
-        
+    beginRiderFrames();
+    
+    // Du plus lointain au plus proche : ordre de priorité des sprites.
+    // Les strips vont aussi de l'horizon vers le joueur : un seul parcours
+    // conjoint place chaque rider sur la ligne de route de sa profondeur.
+    for (n = 0; n < aiOrderCount; n++) {
+        u8 i = aiOrder[n];
         AIRider* rider = &aiRiders[i];
         
-        // Calcul de la position d'affichage basée sur la profondeur
-        s32 playerWorldZ = trackPosition << 16;
-        s32 relativeZ = rider->worldZ - playerWorldZ;
+        if (!(aiHot.flags[i] & AI_FLAG_VISIBLE)) continue;
+        
+        // Profondeur relative au joueur, à l'échelle de roadStripDepth
+        s32 depth = (aiHot.worldZ[i] - playerWorldZ) >> (16 - ROAD_DEPTH_SHIFT);
         
-        // Projection pseudo-3D
-        if (relativeZ > 0) {
-            // Derrière le joueur - plus petit
-            rider->y = 200;
+        while (s < roadStripCount && roadStripDepth[s] > depth) s++;
+        
+        if (s >= roadStripCount) {
+            // Derrière la caméra : hors écran
+            aiHot.y[i] = SCREEN_HEIGHT;
+            rider->screenScale = 0;
         } else {
-            // Devant le joueur - taille normale
-            rider->y = 120 + ((-relativeZ) >> 18); // Plus haut si plus loin
+            // Ligne de route, virage compris ; écart latéral à l'échelle du strip
+            const RoadStrip* strip = &roadStrips[s];
+            
+            aiHot.y[i] = strip->screenY;
+            rider->screenScale = strip->scale;
+            rider->screenX = ROAD_CENTER_X + strip->roadXOffset +
+                             (((s32)(aiHot.x[i] - ROAD_CENTER_X) * strip->scale) >> 8);
         }
         
-        // Mise à jour position sprite
-        if (rider->spriteIndex != 0xFF) {
-            // Pour SGDK, nous ne pouvons pas facilement mettre à jour la position individuellement
-            // Il faudrait un système de gestion plus sophistiqué des sprites
-            // Pour l'instant, on laisse comme placeholder
+        // Mise à jour position sprite, profondeur = distance au joueur (unités)
+        if (rider->spriteIndex != SPRITE_NONE) {
+            if (rider->screenScale == 0) {
+                hideSpriteSlot(rider->spriteIndex);
+            } else {
+                s32 units = (depth < 0) ? 0 : min(depth >> ROAD_DEPTH_SHIFT, 0xFFFF);
+                u8 frames = entityKinds[rider->kind].frames;
+                u8 size, tiles;
+                u16 tile;
+                
+                if (frames == ENTITY_RIDER_FRAMES) {
+                    // Frame à l'échelle de la profondeur, envoyée seulement si
+                    // elle a changé ; size = côté affiché en pixels, 0 tant
+                    // qu'aucune frame n'a pu être mise en file
+                    size = updateRiderFrame(rider->frameSlot, rider->aiType % RIDER_DESIGNS,
+                                            rider->screenScale, rider->animFrame);
+                    tiles = (size + 7) >> 3;
+                    tile = RIDER_SLOT_TILE(rider->frameSlot);
+                } else {
+                    // Objet de la banque de décor, déjà en VRAM à tous les zooms
+                    tile = getSceneryFrame(frames, rider->screenScale, &tiles);
+                    size = tiles << 3;
+                }
+                
+                // Centré sur la ligne de route, roues sur le strip
+                if (size == 0) hideSpriteSlot(rider->spriteIndex);
+                else placeSpriteSlot(rider->spriteIndex,
+                                     rider->screenX - (size >> 1), aiHot.y[i] - size,
+                                     TILE_ATTR_FULL(PAL1, 0, FALSE, FALSE, tile),
+                                     SPRITE_SIZE(tiles, tiles), units);
+            }
             
             // Animation
-            updateAIAnimation(rider);
+            updateAIAnimation(i);
         }
     }
 }
 
-void updateAIAnimation(AIRider* rider) {
+void updateAIAnimation(u8 id) {
+    AIRider* rider = &aiRiders[id];
+    
     rider->animTimer++;
     
     if (rider->animTimer >= 8) { // Change frame toutes les 8 frames
         rider->animTimer = 0;
-        rider->animFrame = (rider->animFrame + 1) % 4; // 4 frames d'animation
+        rider->animFrame = (rider->animFrame + 1) % RIDER_ANIM_FRAMES;
         
         // Mise à jour de la frame du sprite
-        if (rider->spriteIndex != 0xFF) {
+        if (rider->spriteIndex != SPRITE_NONE) {
             // Pour SGDK, changement de frame nécessite une approche différente
             // Placeholder pour l'instant
         }
@@ -510,20 +438,32 @@ void updateAIAnimation(AIRider* rider) {
 
 // === INTERFACE PUBLIQUE ===
 
-void updateAISystem(s16 roadCurve) {
-    u8 i;
+void updateAISystem(void) {
+    // Retraits depuis la dernière passe (peloton, culling) : ordre rétabli
+    // avant les recherches par Z
+    if (aiOrderDirty) updateRiderOrder();
     
-    // Mise à jour de chaque rider actif
-    for (i = 0; i < activeRiders; i++) {
-        if (!aiRiders[i].active) continue;
-        
-        updateAIDecisions(&aiRiders[i]);
-        updateAIPhysics(&aiRiders[i], roadCurve);
-    }
+    // Choix des riders mis à jour cette frame (lodDt)
+    aiLodUpdates = scheduleAILOD();
+    
+    // Occupation des couloirs devant le joueur (requêtes des décisions)
+    buildLaneMap();
+    
+    // Décisions : slot du tour + urgences, nombre borné par frame
+    aiDecisionCount = scheduleAIDecisions();
+    
+    // Physique de tous les riders en une passe
+    updateAIPhysics();
+    
+    // Remise en ordre par worldZ (quelques comparaisons par frame)
+    updateRiderOrder();
     
     // Gestion des collisions
     checkAICollisions();
     
+    // Entités retirées par les contacts : ordre rétabli avant le rendu
+    if (aiOrderDirty) updateRiderOrder();
+    
     // Mise à jour visibilité et culling
     updateAIVisibility();
     
@@ -531,21 +471,150 @@ void updateAISystem(s16 roadCurve) {
     renderAIRiders();
 }
 
-void disableAIRider(AIRider* rider) {
-    releaseSpriteFromAI(rider);
-    rider->active = FALSE;
-    rider->visible = FALSE;
+void disableAIRider(u8 id) {
+    AIRider* rider = &aiRiders[id];
     
-    // Compactage du tableau (optionnel)
-    // Plus simple : marquer comme inactif et réutiliser plus tard
+    if (!(aiHot.flags[id] & AI_FLAG_ACTIVE)) return;
+    
+    // Concurrent du peloton libéré sans rétrogradation (KO) : hors course,
+    // pas de reprise analytique
+    if (rider->fieldIndex != AI_NO_RIDER) {
+        retireFieldEntry(rider->fieldIndex);
+        rider->fieldIndex = AI_NO_RIDER;
+    }
+    
+    releaseSpriteFromAI(id);
+    if (aiHot.flags[id] & ENT_FLAG_AI) releaseDecisionSlot(id);
+    aiHot.flags[id] = 0;
+    aiHot.lodDt[id] = 0;
+    
+    // Retrait de la liste des vivants : le dernier prend sa place
+    u8 last = aiLive[--activeRiders];
+    aiLive[rider->poolLink] = last;
+    aiRiders[last].poolLink = rider->poolLink;
+    
+    // Retour en tête de la liste libre ; les handles existants deviennent périmés
+    rider->generation++;
+    rider->poolLink = aiFreeHead;
+    aiFreeHead = id;
+    
+    // Retrait de l'ordre de course : le dernier prend sa place, l'ordre
+    // n'est plus trié si ce n'était pas lui (rétabli par updateRiderOrder)
+    u8 moved = aiOrder[--aiOrderCount];
+    
+    if (moved != id) {
+        aiOrder[rider->orderIndex] = moved;
+        aiRiders[moved].orderIndex = rider->orderIndex;
+        aiOrderDirty = TRUE;
+    }
+}
+
+// === ORDRE DE COURSE ===
+
+void updateRiderOrder(void) {
+    u8 n, k;
+    
+    // Tri par insertion : O(n) quand l'ordre n'a pas changé
+    for (n = 1; n < aiOrderCount; n++) {
+        u8 id = aiOrder[n];
+        s32 z = aiHot.worldZ[id];
+        
+        k = n;
+        while (k > 0 && aiHot.worldZ[aiOrder[k - 1]] < z) {
+            aiOrder[k] = aiOrder[k - 1];
+            aiRiders[aiOrder[k]].orderIndex = k;
+            k--;
+        }
+        aiOrder[k] = id;
+        aiRiders[id].orderIndex = k;
+    }
+    
+    aiOrderDirty = FALSE;
+}
+
+u8 findOrderIndexForZ(s32 worldZ) {
+    u8 lo = 0;
+    u8 hi = aiOrderCount;
+    
+    // Premier index de l'ordre dont le rider n'est pas devant worldZ
+    while (lo < hi) {
+        u8 mid = (lo + hi) >> 1;
+        
+        if (aiHot.worldZ[aiOrder[mid]] > worldZ) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    
+    return lo;
+}
+
+// === NIVEAU DE DETAIL ===
+
+u8 scheduleAILOD(void) {
+    s32 playerWorldZ = trackPosition << 16;
+    u8 updates = 0;
+    u8 n;
+    
+    aiLodFrame++;
+    
+    for (n = 0; n < aiOrderCount; n++) {
+        u8 id = aiOrder[n];
+        AIRider* rider = &aiRiders[id];
+        s32 distance = abs(aiHot.worldZ[id] - playerWorldZ);
+        u8 elapsed;
+        
+        // Entités immobiles : jamais intégrées par la physique
+        if (!(aiHot.flags[id] & ENT_FLAG_MOTION)) {
+            aiHot.lodDt[id] = 0;
+            continue;
+        }
+        
+        // Bande de distance -> période de mise à jour
+        if (distance < AI_LOD_NEAR) {
+            rider->lodShift = 0;
+        } else if (distance < AI_LOD_MID) {
+            rider->lodShift = 1;
+        } else if (distance < AI_LOD_FAR) {
+            rider->lodShift = 2;
+        } else {
+            rider->lodShift = 3;
+        }
+        
+        // Décalage par index : les riders d'une même bande se répartissent
+        // sur les frames de la période
+        if (((aiLodFrame + id) & ((1 << rider->lodShift) - 1)) != 0) {
+            aiHot.lodDt[id] = 0;
+            continue;
+        }
+        
+        // Frames écoulées depuis la dernière mise à jour
+        elapsed = aiLodFrame - rider->lodLastFrame;
+        if (elapsed > AI_LOD_MAX_DT) elapsed = AI_LOD_MAX_DT;
+        
+        rider->lodLastFrame = aiLodFrame;
+        aiHot.lodDt[id] = elapsed;
+        updates++;
+    }
+    
+    return updates;
 }
 
-u8 findFreeSprite(void) {
-    // Version simplifiée pour la compilation
-    static u8 nextSprite = 1; // Sprite 0 réservé au joueur
+// === HANDLES ===
+
+AIHandle getRiderHandle(u8 id) {
+    return ((AIHandle)aiRiders[id].generation << 8) | id;
+}
+
+u8 resolveRiderHandle(AIHandle handle) {
+    u8 id = handle & 0xFF;
     
-    if (nextSprite < 16) { // Max 16 sprites IA simultanés
-        return nextSprite++;
+    // Emplacement réutilisé ou libéré depuis la création du handle
+    if (id >= MAX_AI_RIDERS || !(aiHot.flags[id] & AI_FLAG_ACTIVE) ||
+        aiRiders[id].generation != (handle >> 8)) {
+        return AI_NO_RIDER;
     }
-    return 0xFF;
-}
\ No newline at end of file
+    
+    return id;
+}
@@ -0,0 +1,120 @@
+/* dma_queue.c - File de DMA unique, vidée au vblank dans un budget d'octets */
+
+#include <genesis.h>
+#include "dma_queue.h"
+
+typedef struct {
+    const u8* from;
+    u16 to;                  // Destination (octets)
+    u16 length;              // Mots restant à envoyer
+    u8 type;                 // DMA_VRAM, DMA_CRAM ou DMA_VSRAM
+    u8 priority;
+    volatile u8* busy;
+} DMAJob;
+
+DMAQueueStats dmaStats;
+
+static DMAJob dmaJobs[DMA_QUEUE_JOBS];
+static u8 dmaJobCount = 0;
+static u16 dmaBudget = DMA_BUDGET_NTSC;
+
+void initDMAQueue(void) {
+    dmaJobCount = 0;
+    dmaBudget = SYS_isPAL() ? DMA_BUDGET_PAL : DMA_BUDGET_NTSC;
+    memset(&dmaStats, 0, sizeof(dmaStats));
+    
+    SYS_setVBlankCallback(flushDMAQueue);
+}
+
+u16 getDMABudget(void) {
+    return dmaBudget;
+}
+
+bool queueDMAJob(DMAType type, const void* from, u16 to, u16 length, u8 priority, volatile u8* busy) {
+    DMAJob* job;
+    
+    if (length == 0) return TRUE;
+    
+    // Un job normal plus gros que tout le budget ne partirait jamais entier
+    if (priority == DMA_PRIORITY_NORMAL && (u32)length * 2 > dmaBudget) {
+        priority = DMA_PRIORITY_LOW;
+    }
+    
+    // La file est vidée sous interruption : pas de vblank pendant l'ajout
+    SYS_disableInts();
+    
+    if (dmaJobCount >= DMA_QUEUE_JOBS) {
+        SYS_enableInts();
+        dmaStats.jobsDropped++;
+        return FALSE;
+    }
+    
+    job = &dmaJobs[dmaJobCount++];
+    job->from = (const u8*) from;
+    job->to = to;
+    job->length = length;
+    job->type = type;
+    job->priority = priority;
+    job->busy = busy;
+    if (busy) *busy = TRUE;
+    
+    SYS_enableInts();
+    return TRUE;
+}
+
+static void sendJob(DMAJob* job, u16 length) {
+    DMA_doDma(job->type, (void*) job->from, job->to, length, 2);
+    
+    job->from += length << 1;
+    job->to += length << 1;
+    job->length -= length;
+    
+    if (job->length == 0 && job->busy) *job->busy = FALSE;
+}
+
+void flushDMAQueue(void) {
+    // Callback de vblank : priorités dans l'ordre, jobs dans l'ordre d'arrivée
+    u16 left = dmaBudget;
+    u16 sent = 0;
+    u16 deferred = 0;
+    u8 priority, n, kept;
+    
+    for (priority = 0; priority < DMA_PRIORITIES; priority++) {
+        for (n = 0; n < dmaJobCount; n++) {
+            DMAJob* job = &dmaJobs[n];
+            u16 bytes = job->length << 1;
+            
+            if (job->priority != priority || job->length == 0) continue;
+            
+            if (bytes <= left || priority == DMA_PRIORITY_HIGH) {
+                sendJob(job, job->length);
+                left = (bytes < left) ? left - bytes : 0;
+                sent += bytes;
+            }
+            else if (priority == DMA_PRIORITY_LOW && left >= DMA_SPLIT_MIN) {
+                // Transfert de fond : la part qui tient, le reste au prochain vblank
+                u16 part = left >> 1;
+                
+                sendJob(job, part);
+                left -= part << 1;
+                sent += part << 1;
+            }
+        }
+    }
+    
+    // Jobs restants ramenés en tête, dans leur ordre
+    kept = 0;
+    for (n = 0; n < dmaJobCount; n++) {
+        if (dmaJobs[n].length == 0) continue;
+        
+        deferred += dmaJobs[n].length << 1;
+        if (kept != n) dmaJobs[kept] = dmaJobs[n];
+        kept++;
+    }
+    dmaJobCount = kept;
+    
+    dmaStats.bytesSent = sent;
+    dmaStats.bytesDeferred = deferred;
+    dmaStats.totalSent += sent;
+    if (kept) dmaStats.framesOverBudget++;
+}
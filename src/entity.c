@@ -0,0 +1,150 @@
+/* entity.c - Types d'entités de la route et réponses aux contacts */
+
+#include <genesis.h>
+#include "ai_riders.h"
+#include "entity.h"
+#include "fast_random.h"
+#include "scenery.h"
+
+#define TRAFFIC_DAMAGE    10     // Santé perdue contre une voiture
+#define TRAFFIC_CRASH     60     // Frames au sol pour un rider percuté
+#define OIL_SKID          24     // Écart latéral max d'un dérapage (±px)
+#define OIL_DURATION      30     // Frames de dérapage d'un rider
+#define PICKUP_HEALTH     25     // Santé rendue par un bonus
+#define MAX_HEALTH        100
+
+extern u16 playerHealth;
+
+static void trafficContact(u8 id, u8 other);
+static void oilSlickContact(u8 id, u8 other);
+static void pickupContact(u8 id, u8 other);
+
+const EntityKindInfo entityKinds[ENTITY_KIND_COUNT] = {
+    [ENTITY_RIDER] = {
+        .components = ENT_FLAG_AI | ENT_FLAG_COLLIDER | ENT_FLAG_MOTION | ENT_FLAG_SOLID,
+        .cruiseSpeed = 0, .acceleration = 0, .onContact = NULL,
+        .frames = ENTITY_RIDER_FRAMES
+    },
+    [ENTITY_TRAFFIC] = {
+        .components = ENT_FLAG_COLLIDER | ENT_FLAG_MOTION | ENT_FLAG_SOLID,
+        .cruiseSpeed = 120, .acceleration = 2, .onContact = trafficContact,
+        .frames = SCENERY_CAR
+    },
+    [ENTITY_OIL_SLICK] = {
+        .components = ENT_FLAG_COLLIDER | ENT_FLAG_SOLID,
+        .cruiseSpeed = 0, .acceleration = 0, .onContact = oilSlickContact,
+        .frames = SCENERY_OIL
+    },
+    [ENTITY_PICKUP] = {
+        .components = ENT_FLAG_COLLIDER,
+        .cruiseSpeed = 0, .acceleration = 0, .onContact = pickupContact,
+        .frames = SCENERY_PICKUP
+    }
+};
+
+u8 spawnEntity(EntityKind kind, s32 worldZ, s16 x) {
+    const EntityKindInfo* info = &entityKinds[kind];
+    u8 id;
+    
+    // Les riders ont besoin d'un type d'IA : spawnAIRider
+    if (kind == ENTITY_RIDER || kind >= ENTITY_KIND_COUNT) return AI_NO_RIDER;
+    
+    id = allocEntity(kind, worldZ, x);
+    if (id == AI_NO_RIDER) return AI_NO_RIDER;
+    
+    // Ligne fixe : sans maniabilité la physique ne change pas x
+    aiHot.maxSpeed[id] = info->cruiseSpeed;
+    aiHot.acceleration[id] = info->acceleration;
+    aiHot.handling[id] = 0;
+    aiHot.speed[id] = info->cruiseSpeed;
+    aiHot.targetX[id] = x;
+    
+    return id;
+}
+
+void resolveEntityContact(u8 a, u8 b) {
+    // Un membre libéré plus tôt dans la frame (KO, bonus ramassé)
+    if (!(aiHot.flags[a] & AI_FLAG_ACTIVE)) return;
+    
+    if (b == AI_CONTACT_PLAYER) {
+        if (aiHot.flags[a] & ENT_FLAG_AI) {
+            handlePlayerAICollision(a);
+            triggerCollisionEffects(aiHot.x[a], aiHot.y[a]);
+        } else {
+            entityKinds[aiRiders[a].kind].onContact(a, AI_CONTACT_PLAYER);
+        }
+        return;
+    }
+    
+    if (!(aiHot.flags[b] & AI_FLAG_ACTIVE)) return;
+    
+    // Le type sans IA décide de l'effet sur le rider ; entre deux entités
+    // sans IA (voiture sur une flaque), rien
+    if (aiHot.flags[a] & ENT_FLAG_AI) {
+        if (aiHot.flags[b] & ENT_FLAG_AI) {
+            handleAICollision(a, b);
+        } else {
+            entityKinds[aiRiders[b].kind].onContact(b, a);
+        }
+    } else if (aiHot.flags[b] & ENT_FLAG_AI) {
+        entityKinds[aiRiders[a].kind].onContact(a, b);
+    }
+}
+
+// === REPONSES PAR TYPE ===
+
+static void trafficContact(u8 id, u8 other) {
+    if (other == AI_CONTACT_PLAYER) {
+        // Choc frontal : le joueur perd la moitié de sa vitesse et est repoussé
+        playerSpeed >>= 1;
+        playerHealth = (playerHealth > TRAFFIC_DAMAGE) ? playerHealth - TRAFFIC_DAMAGE : 0;
+        playerX += (aiHot.x[id] > playerX) ? -10 : 10;
+        triggerCollisionEffects(aiHot.x[id], aiHot.y[id]);
+        return;
+    }
+    
+    AIRider* rider = &aiRiders[other];
+    
+    // Un rider déjà au sol ne subit pas un second choc pendant le contact
+    if (rider->state == AI_STATE_CRASHED) return;
+    
+    aiHot.speed[other] >>= 2;
+    rider->state = AI_STATE_CRASHED;
+    rider->stateTimer = TRAFFIC_CRASH;
+    rider->health -= TRAFFIC_DAMAGE;
+    
+    if (rider->health <= 0) {
+        disableAIRider(other);
+    } else {
+        requestUrgentDecision(other, AI_URGENT_COLLISION);
+    }
+}
+
+static void oilSlickContact(u8 id, u8 other) {
+    if (other == AI_CONTACT_PLAYER) {
+        // Glisse tant que le joueur est sur la flaque
+        playerX += randomSpread(RANDOM_STREAM_EFFECTS, 3);
+        return;
+    }
+    
+    AIRider* rider = &aiRiders[other];
+    
+    if (rider->state == AI_STATE_AVOIDING || rider->state == AI_STATE_CRASHED) return;
+    
+    // Dérapage : écart latéral aléatoire et perte d'un quart de la vitesse
+    aiHot.targetX[other] = aiHot.x[other] + randomSpread(RANDOM_STREAM_AI, OIL_SKID);
+    aiHot.speed[other] -= aiHot.speed[other] >> 2;
+    rider->state = AI_STATE_AVOIDING;
+    rider->stateTimer = OIL_DURATION;
+}
+
+static void pickupContact(u8 id, u8 other) {
+    // Ramassé par le premier arrivé, joueur ou rider
+    if (other == AI_CONTACT_PLAYER) {
+        playerHealth = min(playerHealth + PICKUP_HEALTH, MAX_HEALTH);
+    } else {
+        aiRiders[other].health = min(aiRiders[other].health + PICKUP_HEALTH, MAX_HEALTH);
+    }
+    
+    disableAIRider(id);
+}
@@ -0,0 +1,109 @@
+/* fast_random.s - Générateur pseudo-aléatoire xorshift32 à flux multiples */
+
+#include "fast_random.h"
+
+.text
+.global seedRandomStreams
+.global fastRandomASM
+.global randomRangeASM
+
+/* Constantes */
+SEED_STEP = 0x9E3779B9      /* Écart entre les graines de deux flux */
+SEED_ZERO = 0x6C078965      /* Remplace un état nul (point fixe de xorshift) */
+
+/*
+ * Fonction: seedRandomStreams
+ * void seedRandomStreams(u32 seed)
+ * Initialise chaque flux à seed + n * SEED_STEP (jamais nul)
+ * Paramètres (pile, ABI m68k-elf GCC):
+ *   4(sp) = seed
+ */
+seedRandomStreams:
+    move.l 4(sp), d0
+    lea randomStreams, a0
+    moveq #RANDOM_STREAM_COUNT - 1, d1
+
+seed_loop:
+    tst.l d0
+    bne.s seed_store
+    move.l #SEED_ZERO, d0
+seed_store:
+    move.l d0, (a0)+
+    add.l #SEED_STEP, d0
+    dbra d1, seed_loop
+    rts
+
+/*
+ * Fonction: fastRandomASM
+ * u16 fastRandomASM(u16 stream)
+ * Avance le flux (x ^= x << 13, x ^= x >> 17, x ^= x << 5) et retourne
+ * le mot bas du nouvel état
+ * Paramètres (pile, ABI m68k-elf GCC):
+ *   4(sp) = stream (mot bas en 6)
+ * Retour:
+ *   d0 = tirage 16 bits
+ */
+fastRandomASM:
+    move.w 6(sp), d0
+    lsl.w #2, d0
+    lea randomStreams, a0
+    adda.w d0, a0               /* a0 = &randomStreams[stream] */
+    bsr.s random_step
+    swap d0
+    clr.w d0
+    swap d0                     /* d0 = mot bas, étendu sans signe */
+    rts
+
+/*
+ * Fonction: randomRangeASM
+ * u16 randomRangeASM(u16 stream, u16 range)
+ * Tirage uniforme dans [0, range[ sans division : (tirage * range) >> 16
+ * Paramètres (pile, ABI m68k-elf GCC):
+ *   4(sp) = stream (mot bas en 6), 8(sp) = range (mot bas en 10)
+ * Retour:
+ *   d0 = tirage dans [0, range[ (0 si range = 0)
+ */
+randomRangeASM:
+    move.w 6(sp), d0
+    lsl.w #2, d0
+    lea randomStreams, a0
+    adda.w d0, a0               /* a0 = &randomStreams[stream] */
+    bsr.s random_step
+    mulu.w 10(sp), d0           /* d0 = tirage * range */
+    clr.w d0
+    swap d0                     /* d0 = mot haut du produit */
+    rts
+
+/*
+ * Pas xorshift32 sur le flux pointé par a0
+ * Entrée: a0 = &état ; Sortie: d0.l = nouvel état (mot bas = tirage)
+ * Utilise d1
+ */
+random_step:
+    move.l (a0), d0
+
+    /* x ^= x << 13 */
+    move.l d0, d1
+    lsl.l #8, d1
+    lsl.l #5, d1
+    eor.l d1, d0
+
+    /* x ^= x >> 17 */
+    move.l d0, d1
+    clr.w d1
+    swap d1
+    lsr.w #1, d1
+    eor.l d1, d0
+
+    /* x ^= x << 5 */
+    move.l d0, d1
+    lsl.l #5, d1
+    eor.l d1, d0
+
+    move.l d0, (a0)
+    rts
+
+.bss
+.even
+randomStreams:
+    .ds.l RANDOM_STREAM_COUNT
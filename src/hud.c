@@ -0,0 +1,172 @@
+/* hud.c - HUD sur le plan fenêtre : champs réécrits seulement quand ils changent */
+
+#include <genesis.h>
+#include "hud.h"
+#include "dma_queue.h"
+#include "vram_layout.h"
+
+#define HUD_PLANE_WIDTH      64      // Fenêtre de 64 cellules en H40
+#define HUD_CLEAN            0xFF
+#define HUD_BLANK            0
+
+// Police SGDK en VRAM_FONT_TILE, à partir du caractère ' '
+#define HUD_TILE(c)          TILE_ATTR_FULL(PAL0, TRUE, FALSE, FALSE, VRAM_FONT_TILE + (c) - 32)
+
+// Disposition (colonne, ligne) des champs
+#define HUD_SCORE_X          7
+#define HUD_SCORE_DIGITS     6
+#define HUD_HEALTH_X         30
+#define HUD_HEALTH_BARS      10
+#define HUD_SPEED_X          7
+#define HUD_SPEED_DIGITS     3
+#define HUD_POSITION_X       17
+#define HUD_LEVEL_X          31
+#define HUD_SMALL_DIGITS     2
+
+static const struct {
+    u8 x;
+    u8 y;
+    const char* text;
+} hudLabels[] = {
+    { 1, 1, "SCORE:" },
+    { 23, 1, "HEALTH:" },
+    { 1, 2, "SPEED:" },
+    { 13, 2, "POS:" },
+    { 19, 2, "/" },
+    { 25, 2, "LEVEL:" }
+};
+
+#define HUD_LABELS (sizeof(hudLabels) / sizeof(hudLabels[0]))
+
+static u16 hudMap[HUD_ROWS][HUD_COLUMNS];
+static u8 dirtyFirst[HUD_ROWS];
+static u8 dirtyLast[HUD_ROWS];
+static volatile u8 rowQueued[HUD_ROWS];
+
+// Entrées de tilemap des chiffres, et chiffres de chaque nombre 00-99
+static u16 hudDigitTiles[10];
+static u8 hudPairs[100][2];
+
+// Valeurs affichées ; health à 0xFFFF tant que rien ne l'est
+static HUDValues shown;
+
+static void setHUDTile(u8 x, u8 y, u16 tile) {
+    if (hudMap[y][x] == tile) return;
+    
+    hudMap[y][x] = tile;
+    if (dirtyFirst[y] == HUD_CLEAN || x < dirtyFirst[y]) dirtyFirst[y] = x;
+    if (dirtyLast[y] == HUD_CLEAN || x > dirtyLast[y]) dirtyLast[y] = x;
+}
+
+static void flushHUD(void) {
+    u8 y;
+    
+    for (y = 0; y < HUD_ROWS; y++) {
+        u8 first = dirtyFirst[y];
+        
+        if (first == HUD_CLEAN || rowQueued[y]) continue;
+        
+        if (!queueDMAJob(DMA_VRAM, &hudMap[y][first],
+                         VRAM_WINDOW + ((y * HUD_PLANE_WIDTH) + first) * 2,
+                         dirtyLast[y] - first + 1, DMA_PRIORITY_NORMAL, &rowQueued[y])) {
+            return;          // File pleine : nouvel essai à la frame suivante
+        }
+        dirtyFirst[y] = HUD_CLEAN;
+        dirtyLast[y] = HUD_CLEAN;
+    }
+}
+
+void initHUD(void) {
+    u8 x, y, i;
+    
+    for (i = 0; i < 10; i++) {
+        hudDigitTiles[i] = HUD_TILE('0' + i);
+    }
+    for (i = 0; i < 100; i++) {
+        hudPairs[i][0] = i / 10;
+        hudPairs[i][1] = i % 10;
+    }
+    
+    // Cadre complet au premier envoi, y compris les cellules vides
+    for (y = 0; y < HUD_ROWS; y++) {
+        for (x = 0; x < HUD_COLUMNS; x++) {
+            hudMap[y][x] = HUD_BLANK;
+        }
+        dirtyFirst[y] = 0;
+        dirtyLast[y] = HUD_COLUMNS - 1;
+        rowQueued[y] = FALSE;
+    }
+    
+    for (i = 0; i < HUD_LABELS; i++) {
+        const char* text = hudLabels[i].text;
+        
+        for (x = hudLabels[i].x; *text; text++, x++) {
+            setHUDTile(x, hudLabels[i].y, HUD_TILE(*text));
+        }
+    }
+    
+    shown.health = 0xFFFF;
+    
+    // Fenêtre sur les HUD_ROWS premières lignes, par-dessus le plan A
+    VDP_setWindowVPos(FALSE, HUD_ROWS);
+    flushHUD();
+}
+
+// Nombre sur digits cellules, cadré à droite ; pad : zéros de tête
+// affichés, sinon remplacés par des blancs (au moins un chiffre)
+static void writeNumber(u8 x, u8 y, u16 value, u8 digits, bool pad) {
+    s8 n = digits - 1;
+    
+    while (n >= 0) {
+        const u8* pair = hudPairs[value % 100];
+        
+        value /= 100;
+        setHUDTile(x + n--, y, hudDigitTiles[pair[1]]);
+        if (n >= 0) setHUDTile(x + n--, y, hudDigitTiles[pair[0]]);
+    }
+    
+    if (pad) return;
+    
+    for (n = 0; n < digits - 1 && hudMap[y][x + n] == hudDigitTiles[0]; n++) {
+        setHUDTile(x + n, y, HUD_BLANK);
+    }
+}
+
+void updateHUD(const HUDValues* values) {
+    bool first = (shown.health == 0xFFFF);
+    
+    if (first || values->score != shown.score) {
+        writeNumber(HUD_SCORE_X, 1, values->score, HUD_SCORE_DIGITS, TRUE);
+        shown.score = values->score;
+    }
+    
+    if (first || values->health != shown.health) {
+        u8 bars = values->health / 10;
+        u8 i;
+        
+        for (i = 0; i < HUD_HEALTH_BARS; i++) {
+            setHUDTile(HUD_HEALTH_X + i, 1, HUD_TILE((i < bars) ? '|' : '.'));
+        }
+        shown.health = values->health;
+    }
+    
+    if (first || values->speed != shown.speed) {
+        writeNumber(HUD_SPEED_X, 2, (values->speed < 0) ? 0 : values->speed,
+                    HUD_SPEED_DIGITS, FALSE);
+        shown.speed = values->speed;
+    }
+    
+    if (first || values->position != shown.position || values->riders != shown.riders) {
+        writeNumber(HUD_POSITION_X, 2, values->position, HUD_SMALL_DIGITS, FALSE);
+        writeNumber(HUD_POSITION_X + 3, 2, values->riders, HUD_SMALL_DIGITS, FALSE);
+        shown.position = values->position;
+        shown.riders = values->riders;
+    }
+    
+    if (first || values->level != shown.level) {
+        writeNumber(HUD_LEVEL_X, 2, values->level, HUD_SMALL_DIGITS, FALSE);
+        shown.level = values->level;
+    }
+    
+    flushHUD();
+}
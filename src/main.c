@@ -4,6 +4,20 @@
 #include "resources.h"
 #include "ai_riders.h"
 #include "ai_integration.h"
+#include "ai_field.h"
+#include "fast_random.h"
+#include "track.h"
+#include "road.h"
+#include "sprites.h"
+#include "dma_queue.h"
+#include "palettes.h"
+#include "text_buffer.h"
+#include "hud.h"
+#include "scenery.h"
+#include "vram_layout.h"
+
+_Static_assert(VRAM_USER_TILE == TILE_USER_INDEX, "vram_layout.h: VRAM_USER_TILE != TILE_USER_INDEX");
+_Static_assert(VRAM_FONT_TILES >= FONT_LEN, "vram_layout.h: VRAM_FONT_TILES < FONT_LEN");
 
 // Prototypes de fonctions
 void performPlayerAttack(void);
@@ -16,31 +30,11 @@ void renderDebugInfo(void);
 
 // === STRUCTURES DE BASE (inchangées) ===
 
-typedef struct {
-    s16 curve;         
-    s16 hill;          
-    u16 length;        
-    u8 decorType;      
-    u8 roadType;       
-    u8 paletteIndex;   
-    u8 eventFlags;     
-} TrackSegment;
-
-typedef struct {
-    u16 screenY;       
-    u16 roadWidth;     
-    s16 roadXOffset;   
-    u16 scale;         
-} RoadStrip;
-
 // === VARIABLES GLOBALES ===
 
-#define MAX_STRIPS 120
-#define SCREEN_HEIGHT 224
-#define ROAD_BASE_WIDTH 160
-#define HORIZON_Y 80
-
 RoadStrip roadStrips[MAX_STRIPS];
+s16 roadStripDepth[MAX_STRIPS];
+u16 roadStripCount = 0;
 TrackSegment level1[] = {
     { 0, 0,  60, 0, 0, 0, 0 },     // ligne droite
     { 15, 2, 80, 1, 1, 1, 0 },     // virage droite + montée
@@ -50,6 +44,36 @@ TrackSegment level1[] = {
     { 0, 0, 0xFFFF, 0, 0, 0, 0 }   // fin du niveau
 };
 
+// Décor du niveau 1, trié par position (unités de piste)
+const SceneryObject level1Scenery[] = {
+    { 10, SCENERY_LEFT, SCENERY_POST },
+    { 10, SCENERY_RIGHT, SCENERY_POST },
+    { 30, SCENERY_RIGHT, SCENERY_TREE },
+    { 45, SCENERY_LEFT, SCENERY_TREE },
+    { 55, SCENERY_RIGHT, SCENERY_SIGN },     // Annonce du virage droite
+    { 70, SCENERY_LEFT, SCENERY_POST },
+    { 85, SCENERY_LEFT, SCENERY_POST },
+    { 100, SCENERY_LEFT, SCENERY_POST },
+    { 110, SCENERY_RIGHT, SCENERY_TREE },
+    { 125, SCENERY_LEFT, SCENERY_TREE },
+    { 135, SCENERY_RIGHT, SCENERY_SIGN },    // Annonce du virage gauche
+    { 150, SCENERY_RIGHT, SCENERY_POST },
+    { 170, SCENERY_RIGHT, SCENERY_POST },
+    { 190, SCENERY_RIGHT, SCENERY_POST },
+    { 200, SCENERY_LEFT, SCENERY_TREE },
+    { 215, SCENERY_LEFT, SCENERY_TREE },
+    { 230, SCENERY_RIGHT, SCENERY_TREE },
+    { 250, SCENERY_LEFT, SCENERY_TREE },
+    { 260, SCENERY_RIGHT, SCENERY_TREE },
+    { 275, SCENERY_LEFT, SCENERY_SIGN },
+    { 290, SCENERY_LEFT, SCENERY_POST },
+    { 310, SCENERY_LEFT, SCENERY_POST },
+    { 325, SCENERY_RIGHT, SCENERY_TREE },
+    { 335, SCENERY_LEFT, SCENERY_POST },
+    { 335, SCENERY_RIGHT, SCENERY_POST },    // Arrivée
+    { SCENERY_END, 0, 0 }
+};
+
 // Variables joueur et jeu
 s32 trackPosition = 0;
 u16 currentSegmentIndex = 0;
@@ -70,11 +94,34 @@ bool debugMode = false;
 // Lookup tables pour optimiser les calculs
 u16 scaleTable[224];
 u16 widthTable[224];
+s16 depthTable[224];     // Profondeur de chaque ligne (road.h)
 
 // Prototypes des routines assembleur (inchangés)
 extern void renderRoadStripsASM(RoadStrip* strips, u16 numStrips);
 extern void clearPlanA(void);
 
+// Tables du VDP aux adresses de vram_layout.h
+void applyVRAMLayout() {
+    VDP_setBGAAddress(VRAM_PLANE_A);
+    VDP_setBGBAddress(VRAM_PLANE_B);
+    VDP_setWindowAddress(VRAM_WINDOW);
+    VDP_setHScrollTableAddress(VRAM_HSCROLL);
+    VDP_setSpriteListAddress(VRAM_SPRITE_TABLE);
+    
+    // Police recopiée dans sa banque : TILE_FONT_INDEX suit la carte de
+    // VDP_init, pas celle-ci, et le texte du jeu lit VRAM_FONT_TILE
+    VDP_loadTileSet(&font_default, VRAM_FONT_TILE, CPU);
+}
+
+// Chargement d'un tileset dans sa banque, refusé s'il la dépasse
+void loadTileBank(const TileSet* tileset, u16 tile, u16 capacity, TransferMethod method) {
+    if (tileset->numTile > capacity) {
+        VDP_drawText("VRAM BANK OVERFLOW", 5, 21);
+        return;
+    }
+    VDP_loadTileSet(tileset, tile, method);
+}
+
 void enable128kMode() {
     VDP_setReg(1, VDP_getReg(1) | 0x80);
 }
@@ -91,10 +138,14 @@ void initLookupTables() {
         if (i < HORIZON_Y) {
             scaleTable[i] = 0;
             widthTable[i] = 0;
+            depthTable[i] = 0;
         } else {
             u16 distance = 224 - i;
             scaleTable[i] = (distance * 256) / (224 - HORIZON_Y);
             widthTable[i] = (ROAD_BASE_WIDTH * scaleTable[i]) >> 8;
+            // Perspective : profondeur en 1/(ligne sous l'horizon), 0 sur la ligne du joueur
+            depthTable[i] = ROAD_CAMERA_DEPTH / (i - HORIZON_Y + 1)
+                          - ROAD_CAMERA_DEPTH / (PLAYER_SCREEN_Y - HORIZON_Y + 1);
         }
     }
 }
@@ -126,6 +177,7 @@ void generateRoadStrips() {
         roadStrips[i].screenY = y;
         roadStrips[i].scale = scaleTable[y];
         roadStrips[i].roadWidth = widthTable[y];
+        roadStripDepth[i] = depthTable[y];
         
         s32 curveEffect = (currentSeg.curve * (224 - y)) >> 4;
         roadStrips[i].roadXOffset = cameraX + curveEffect;
@@ -133,6 +185,8 @@ void generateRoadStrips() {
         if (roadStrips[i].roadXOffset < -320) roadStrips[i].roadXOffset = -320;
         if (roadStrips[i].roadXOffset > 320) roadStrips[i].roadXOffset = 320;
     }
+    
+    roadStripCount = i;
 }
 
 // === GESTION DES ENTRÉES AMÉLIORÉE ===
@@ -148,9 +202,9 @@ void handleInput() {
             startButtonDelay = 30; // Évite le spam
             
             if (gamePaused) {
-                VDP_drawText("** PAUSED **", 14, 12);
+                drawBufferedText("** PAUSED **", 14, 12);
             } else {
-                VDP_drawText("            ", 14, 12);
+                clearBufferedText(14, 12, 12);
             }
         }
         startButtonDelay--;
@@ -225,28 +279,29 @@ void performPlayerAttack() {
     }
     
     // Recherche d'un rider proche à attaquer
-    AIRider* target = getNearestRider(playerX);
+    u8 target = resolveRiderHandle(getNearestRider(playerX));
     
-    if (target != NULL && abs(target->x - playerX) < 32) {
+    if (target != AI_NO_RIDER && abs(aiHot.x[target] - playerX) < 32) {
         // Impact sur le rider IA
-        target->speed = max(target->speed - 20, 0);
-        target->health -= 25;
-        target->state = AI_STATE_CRASHED;
-        target->stateTimer = 90;
+        aiHot.speed[target] = max(aiHot.speed[target] - 20, 0);
+        aiRiders[target].health -= 25;
+        aiRiders[target].state = AI_STATE_CRASHED;
+        aiRiders[target].stateTimer = 90;
+        requestUrgentDecision(target, AI_URGENT_HIT);
         
         // Gain de score
         gameScore += 100;
         
         // Effet visuel
-        VDP_drawText("PUNCH!", 18, 8);
+        drawTimedText("PUNCH!", 18, 8, 30);
         
         // Cooldown de l'attaque
         attackCooldown = 60; // 1 seconde
         
         // Vérification KO
-        if (target->health <= 0) {
+        if (aiRiders[target].health <= 0) {
             gameScore += 500;
-            VDP_drawText("KNOCKOUT!", 16, 9);
+            drawTimedText("KNOCKOUT!", 16, 9, 60);
         }
     }
     
@@ -263,12 +318,11 @@ void updateGame() {
     // Génération de la route
     generateRoadStrips();
     
-    // Obtention de la courbure actuelle pour l'IA
-    TrackSegment currentSeg = getCurrentSegment();
-    s16 roadCurve = currentSeg.curve;
+    // Mise à jour complète du système IA (virages : profil de trajectoire)
+    updateFullAISystem();
     
-    // Mise à jour complète du système IA
-    updateFullAISystem(roadCurve);
+    // Décor de bord de route, projeté sur les strips de la frame
+    updateScenery(trackPosition);
     
     // Vérification de fin de niveau
     checkLevelCompletion();
@@ -302,8 +356,8 @@ void completeLevel() {
     // Bonus de fin de niveau
     gameScore += 1000 + (playerHealth * 10);
     
-    VDP_drawText("LEVEL COMPLETE!", 12, 12);
-    VDP_drawText("BONUS: +1000", 14, 13);
+    drawTimedText("LEVEL COMPLETE!", 12, 12, 120);
+    drawTimedText("BONUS: +1000", 14, 13, 120);
     
     // Passage au niveau suivant (à implémenter)
     currentLevel++;
@@ -312,8 +366,8 @@ void completeLevel() {
     trackPosition = 0;
     resetAISystem();
     
-    // Délai avant le prochain niveau
-    VDP_waitVSync(); // Placeholder pour transition
+    // Transition : fondu au noir puis retour, sur les frames suivantes
+    dipPalette(0, PALETTE_COLORS, 0x0000, 20);
 }
 
 void updatePlayerHealth() {
@@ -329,11 +383,11 @@ void updatePlayerHealth() {
 }
 
 void handleGameOver() {
-    VDP_drawText("GAME OVER", 15, 12);
+    drawBufferedText("GAME OVER", 15, 12);
     
     char scoreText[20];
     sprintf(scoreText, "SCORE: %d", gameScore);
-    VDP_drawText(scoreText, 13, 14);
+    drawBufferedText(scoreText, 13, 14);
     
     // Reset du jeu (simplifié)
     playerHealth = 100;
@@ -344,20 +398,30 @@ void handleGameOver() {
 }
 
 void handleSpecialEvents() {
-    TrackSegment currentSeg = getCurrentSegment();
+    static u32 segmentStart = 0;
+    static s16 enteredSegment = -1;
     
-    // Gestion des événements de segment
-    if (currentSeg.eventFlags != 0) {
-        // Exemple : spawn de riders spéciaux
-        if (currentSeg.eventFlags & 1) { // Bit 0 = spawn agressif
-            if ((gameFrameCounter % 120) == 0) { // Toutes les 2 secondes
-                spawnAIRider(AI_AGGRESSIVE, 
-                           (trackPosition + 200) << 16, 
-                           140 + (random() % 40));
-            }
-        }
-        
-        // Autres événements...
+    // Retour au départ (niveau suivant, game over) : premier segment
+    if (trackPosition < (s32)segmentStart) {
+        currentSegmentIndex = 0;
+        segmentStart = 0;
+    }
+    
+    // Avance segment par segment : une comparaison par frame en général
+    while (level1[currentSegmentIndex + 1].length != TRACK_END_LENGTH &&
+           trackPosition >= (s32)(segmentStart + level1[currentSegmentIndex].length)) {
+        segmentStart += level1[currentSegmentIndex].length;
+        currentSegmentIndex++;
+    }
+    
+    if (currentSegmentIndex == enteredSegment) return;
+    enteredSegment = currentSegmentIndex;
+    
+    // Événements d'entrée dans le segment
+    u8 flags = level1[currentSegmentIndex].eventFlags;
+    
+    if (flags & TRACK_EVENT_SPAWNS) {
+        armSegmentSpawns(TRACK_EVENT_LIST(flags), segmentStart);
     }
 }
 
@@ -375,30 +439,16 @@ void updateSprites() {
 }
 
 void renderUI() {
-    char uiText[32];
-    
-    // Score
-    sprintf(uiText, "SCORE:%06d", gameScore);
-    VDP_drawText(uiText, 1, 1);
+    // HUD sur la fenêtre (hud.c) : seuls les champs modifiés sont réécrits
+    HUDValues hud;
     
-    // Santé du joueur (barre simple)
-    sprintf(uiText, "HEALTH:");
-    VDP_drawText(uiText, 25, 1);
-    
-    // Barre de santé visuelle
-    u8 healthBars = playerHealth / 10;
-    u8 i;
-    for (i = 0; i < 10; i++) {
-        VDP_drawText((i < healthBars) ? "|" : ".", 32 + i, 1);
-    }
-    
-    // Vitesse
-    sprintf(uiText, "SPEED:%d", playerSpeed);
-    VDP_drawText(uiText, 1, 2);
-    
-    // Niveau actuel
-    sprintf(uiText, "LEVEL:%d", currentLevel + 1);
-    VDP_drawText(uiText, 25, 2);
+    hud.score = gameScore;
+    hud.speed = playerSpeed;
+    hud.health = playerHealth;
+    hud.position = getPlayerRacePosition();
+    hud.riders = aiFieldCount + 1;
+    hud.level = currentLevel + 1;
+    updateHUD(&hud);
     
     // Mode debug
     if (debugMode) {
@@ -411,18 +461,18 @@ void renderDebugInfo() {
     
     // Informations techniques
     sprintf(debugText, "POS:%ld", trackPosition);
-    VDP_drawText(debugText, 1, 25);
+    drawBufferedText(debugText, 1, 25);
     
     sprintf(debugText, "CURVE:%d", getCurrentSegment().curve);
-    VDP_drawText(debugText, 12, 25);
+    drawBufferedText(debugText, 12, 25);
     
     sprintf(debugText, "FPS:%d", 60); // Placeholder
-    VDP_drawText(debugText, 25, 25);
+    drawBufferedText(debugText, 25, 25);
     
     // Info IA (depuis ai_integration.c)
     u8 activeAI = getActiveRiderCount();
     sprintf(debugText, "AI:%d", activeAI);
-    VDP_drawText(debugText, 32, 25);
+    drawBufferedText(debugText, 32, 25);
 }
 
 // === FONCTION PRINCIPALE ===
@@ -431,6 +481,7 @@ int main() {
     // Initialisation SGDK selon documentation officielle
     VDP_init();
     VDP_setScreenWidth320();
+    applyVRAMLayout();
 
     /* DEBUG - SPR_init() CAUSE TOUJOURS ARTÉFACTS !
     // Initialisation SPR AVANT tout chargement de tileset
@@ -439,6 +490,14 @@ int main() {
     // SGDK gère automatiquement la VRAM des sprites
     DEBUG */
 
+    // File de DMA (dma_queue.c), vidée par le callback de vblank, puis
+    // gestionnaire de sprites maison (sprites.c) : SAT en RAM mise en file
+    initDMAQueue();
+    initSpriteManager();
+    initPaletteManager();
+    initTextBuffer();
+    initHUD();
+
     // Nettoyage des plans AVANT tout chargement (évite artéfacts)
     VDP_clearPlane(BG_A, TRUE);
     VDP_clearPlane(BG_B, TRUE);
@@ -447,27 +506,32 @@ int main() {
     VDP_drawText("THUNDER OK", 5, 5);
     VDP_drawText("STABLE", 5, 7);
 
-    // DEBUG - Retour à la méthode qui FONCTIONNAIT avant
-    PAL_setPalette(PAL0, main_palette.data, DMA);
-    PAL_setPalette(PAL1, simple_palette.data, DMA);
+    // Palettes de repos (palettes.c), envoyées en CRAM au prochain vblank
+    setPaletteColors(PAL0 * 16, main_palette.data, 16);
+    setPaletteColors(PAL1 * 16, simple_palette.data, 16);
+    updatePalettes();
     VDP_drawText("PALETTES OK", 5, 9);
 
     // Méthode qui FONCTIONNAIT : VDP_loadTileSet avec bons index
     VDP_drawText("LOADING TILES...", 5, 11);
 
+    // Banques de vram_layout.h (les images 128x32 font 64 tuiles chacune)
     if (road_tiles.tileset) {
-        VDP_loadTileSet(road_tiles.tileset, TILE_USER_INDEX, CPU);
+        loadTileBank(road_tiles.tileset, VRAM_ROAD_TILE, VRAM_ROAD_TILES, CPU);
         VDP_drawText("ROAD TILES OK", 5, 13);
     }
     if (grass_tiles.tileset) {
-        VDP_loadTileSet(grass_tiles.tileset, TILE_USER_INDEX + 32, CPU);
+        loadTileBank(grass_tiles.tileset, VRAM_GRASS_TILE, VRAM_GRASS_TILES, CPU);
         VDP_drawText("GRASS TILES OK", 5, 15);
     }
     if (sky_tiles.tileset) {
-        VDP_loadTileSet(sky_tiles.tileset, TILE_USER_INDEX + 64, CPU);
+        loadTileBank(sky_tiles.tileset, VRAM_SKY_TILE, VRAM_SKY_TILES, CPU);
         VDP_drawText("SKY TILES OK", 5, 17);
     }
     
+    // Décor du niveau : tuiles de tous les zooms en transfert de fond
+    initScenery(level1Scenery);
+    
     VDP_drawText("NO SPR_INIT", 5, 19);    /* DEBUG_STEP_4 - sprite_ai_bike désactivé dans resources.res
     player = SPR_addSprite(&sprite_ai_bike, playerX - 8, 190, 
                   TILE_ATTR(PAL1, 0, FALSE, FALSE));
@@ -484,6 +548,7 @@ int main() {
     DEBUG_DISABLE_LOOKUPS */
     
     /* DEBUG_DISABLE_AI - Initialisation du système IA COMMENTÉE
+    buildRacingLine(level1);
     initAIForLevel(currentLevel);
     DEBUG_DISABLE_AI */
     
@@ -494,7 +559,7 @@ int main() {
         for (x = 0; x < 40; x++) {
             VDP_setTileMapXY(BG_B,
                 TILE_ATTR_FULL(PAL0, 0, FALSE, FALSE, 
-                    TILE_USER_INDEX + 16), x, y);
+                    VRAM_SKY_TILE), x, y);
         }
     }
     DEBUG_DISABLE_BACKGROUND */
@@ -508,18 +573,18 @@ int main() {
     
     /* DEBUG_DISABLE_ALL_RESOURCE_LOADING - Tout chargement désactivé
     // Configuration des palettes
-    PAL_setPalette(PAL0, main_palette.data, DMA);
-    PAL_setPalette(PAL1, simple_palette.data, DMA);
+    setPaletteColors(PAL0 * 16, main_palette.data, 16);
+    setPaletteColors(PAL1 * 16, simple_palette.data, 16);
     
     // Chargement des ressources avec vérification
     if (road_tiles.tileset) {
-        VDP_loadTileSet(road_tiles.tileset, TILE_USER_INDEX, DMA);
+        loadTileBank(road_tiles.tileset, VRAM_ROAD_TILE, VRAM_ROAD_TILES, DMA);
     }
     if (grass_tiles.tileset) {
-        VDP_loadTileSet(grass_tiles.tileset, TILE_USER_INDEX + 8, DMA);
+        loadTileBank(grass_tiles.tileset, VRAM_GRASS_TILE, VRAM_GRASS_TILES, DMA);
     }
     if (sky_tiles.tileset) {
-        VDP_loadTileSet(sky_tiles.tileset, TILE_USER_INDEX + 16, DMA);
+        loadTileBank(sky_tiles.tileset, VRAM_SKY_TILE, VRAM_SKY_TILES, DMA);
     }
     
     // Initialisation du sprite joueur
@@ -530,6 +595,7 @@ int main() {
     // initLookupTables(); // Temporairement commenté pour debug
     
     // Initialisation du système IA pour le niveau courant  
+    // buildRacingLine(level1);
     // initAIForLevel(currentLevel); // Temporairement commenté pour debug
     
     // Fond de ciel statique
@@ -537,7 +603,7 @@ int main() {
     for (y = 0; y < 10; y++) {
         for (x = 0; x < 40; x++) {
             VDP_setTileMapXY(BG_B, 
-                TILE_ATTR_FULL(PAL0, 0, 0, 0, TILE_USER_INDEX + 16), x, y);
+                TILE_ATTR_FULL(PAL0, 0, 0, 0, VRAM_SKY_TILE), x, y);
         }
     }
     
@@ -554,6 +620,11 @@ int main() {
         ... code désactivé ...
         DEBUG_DISABLE_ALL_GAME_LOGIC */
 
+        // Effets de palette, texte puis SAT de la frame, envoyés par la file de DMA au vblank
+        updatePalettes();
+        flushTextBuffer();
+        buildSpriteTable();
+
         // Synchronisation VDP et traitement SGDK (évite artefacts)
         SYS_doVBlankProcess();
 
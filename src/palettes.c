@@ -0,0 +1,255 @@
+/* palettes.c - Palettes en RAM, effets par frame, CRAM par plages modifiées */
+
+#include <genesis.h>
+#include "palettes.h"
+#include "dma_queue.h"
+
+#define PALETTE_LINES        (PALETTE_COLORS / PALETTE_LINE_COLORS)
+#define PALETTE_CLEAN        0xFF
+
+typedef enum {
+    PALETTE_JOB_NONE = 0,
+    PALETTE_JOB_FLASH,
+    PALETTE_JOB_FADE,        // Vers job->color
+    PALETTE_JOB_DIP,         // Vers job->color, puis devient un CROSS
+    PALETTE_JOB_CROSS        // Vers les couleurs de repos
+} PaletteJobType;
+
+typedef struct {
+    u8 type;
+    u8 first;
+    u8 count;
+    u8 frames;
+    u8 elapsed;
+    u16 color;
+} PaletteJob;
+
+// paletteWork est relue par le DMA au vblank qui suit sa mise en file
+// (priorité haute, jamais reportée), comme la SAT de sprites.c. Une couleur
+// écrite après la mise en file remarque sa ligne : elle repart à la frame
+// suivante
+static u16 paletteBase[PALETTE_COLORS];     // Couleurs de repos
+static u16 paletteWork[PALETTE_COLORS];     // Image de la CRAM
+static u16 paletteFrom[PALETTE_COLORS];     // Départ des fondus en cours
+static PaletteJob paletteJobs[PALETTE_JOBS];
+
+// Plage modifiée de chaque ligne depuis le dernier envoi
+static u8 dirtyFirst[PALETTE_LINES];
+static u8 dirtyLast[PALETTE_LINES];
+
+static void markDirty(u8 index) {
+    u8 line = index / PALETTE_LINE_COLORS;
+    
+    if (dirtyFirst[line] == PALETTE_CLEAN || index < dirtyFirst[line]) dirtyFirst[line] = index;
+    if (dirtyLast[line] == PALETTE_CLEAN || index > dirtyLast[line]) dirtyLast[line] = index;
+}
+
+static void writeColor(u8 index, u16 color) {
+    if (paletteWork[index] == color) return;
+    
+    paletteWork[index] = color;
+    markDirty(index);
+}
+
+void initPaletteManager(void) {
+    u8 i;
+    
+    for (i = 0; i < PALETTE_COLORS; i++) {
+        paletteBase[i] = 0;
+        paletteWork[i] = 0;
+    }
+    for (i = 0; i < PALETTE_JOBS; i++) {
+        paletteJobs[i].type = PALETTE_JOB_NONE;
+    }
+    
+    // CRAM complète au premier envoi
+    for (i = 0; i < PALETTE_LINES; i++) {
+        dirtyFirst[i] = i * PALETTE_LINE_COLORS;
+        dirtyLast[i] = dirtyFirst[i] + PALETTE_LINE_COLORS - 1;
+    }
+}
+
+static bool clipRange(u16 first, u16* count) {
+    if (first >= PALETTE_COLORS) return FALSE;
+    if (first + *count > PALETTE_COLORS) *count = PALETTE_COLORS - first;
+    
+    return *count > 0;
+}
+
+static void cancelJobs(u16 first, u16 count) {
+    u8 i;
+    
+    for (i = 0; i < PALETTE_JOBS; i++) {
+        PaletteJob* job = &paletteJobs[i];
+        
+        if (job->type == PALETTE_JOB_NONE) continue;
+        if (job->first >= first + count || first >= job->first + job->count) continue;
+        
+        // Effet interrompu : ses couleurs restent où il les avait laissées,
+        // sauf un flash, qui ne doit pas rester affiché
+        if (job->type == PALETTE_JOB_FLASH) {
+            u8 n;
+            
+            for (n = job->first; n < job->first + job->count; n++) {
+                writeColor(n, paletteBase[n]);
+            }
+        }
+        job->type = PALETTE_JOB_NONE;
+    }
+}
+
+void setPaletteColors(u16 first, const u16* colors, u16 count) {
+    u16 i;
+    
+    if (!clipRange(first, &count)) return;
+    
+    cancelJobs(first, count);
+    
+    for (i = 0; i < count; i++) {
+        paletteBase[first + i] = colors[i];
+        writeColor(first + i, colors[i]);
+    }
+}
+
+u16 getPaletteColor(u16 index) {
+    return (index < PALETTE_COLORS) ? paletteWork[index] : 0;
+}
+
+static bool startJob(u8 type, u16 first, u16 count, u16 color, u8 frames) {
+    u8 i, n;
+    
+    if (!clipRange(first, &count)) return FALSE;
+    
+    cancelJobs(first, count);
+    
+    for (i = 0; i < PALETTE_JOBS; i++) {
+        PaletteJob* job = &paletteJobs[i];
+        
+        if (job->type != PALETTE_JOB_NONE) continue;
+        
+        job->type = type;
+        job->first = first;
+        job->count = count;
+        job->frames = frames ? frames : 1;
+        job->elapsed = 0;
+        job->color = color;
+        
+        // Les fondus partent des couleurs affichées
+        for (n = first; n < first + count; n++) {
+            paletteFrom[n] = paletteWork[n];
+        }
+        return TRUE;
+    }
+    
+    return FALSE;
+}
+
+bool flashPalette(u16 first, u16 count, u16 color, u8 frames) {
+    return startJob(PALETTE_JOB_FLASH, first, count, color, frames);
+}
+
+bool fadePalette(u16 first, u16 count, u16 color, u8 frames) {
+    return startJob(PALETTE_JOB_FADE, first, count, color, frames);
+}
+
+bool dipPalette(u16 first, u16 count, u16 color, u8 frames) {
+    return startJob(PALETTE_JOB_DIP, first, count, color, frames);
+}
+
+bool crossFadePalette(u16 first, const u16* colors, u16 count, u8 frames) {
+    u16 i;
+    
+    if (!startJob(PALETTE_JOB_CROSS, first, count, 0, frames)) return FALSE;
+    
+    // Les couleurs de repos changent tout de suite : un effet lancé pendant
+    // le fondu reviendra vers elles
+    for (i = 0; i < count && first + i < PALETTE_COLORS; i++) {
+        paletteBase[first + i] = colors[i];
+    }
+    return TRUE;
+}
+
+bool isPaletteBusy(void) {
+    u8 i;
+    
+    for (i = 0; i < PALETTE_JOBS; i++) {
+        if (paletteJobs[i].type != PALETTE_JOB_NONE) return TRUE;
+    }
+    return FALSE;
+}
+
+static u16 blendColor(u16 from, u16 to, s16 t) {
+    // Composantes de 3 bits (bits 1-3, 5-7, 9-11), t en 8.8
+    u16 color = 0;
+    u8 shift;
+    
+    for (shift = 1; shift <= 9; shift += 4) {
+        s16 a = (from >> shift) & 7;
+        s16 b = (to >> shift) & 7;
+        
+        color |= (u16)(a + (((b - a) * t) >> 8)) << shift;
+    }
+    
+    return color;
+}
+
+static void stepJob(PaletteJob* job) {
+    u8 n, last = job->first + job->count;
+    s16 t;
+    
+    job->elapsed++;
+    
+    if (job->type == PALETTE_JOB_FLASH) {
+        if (job->elapsed == 1) {
+            for (n = job->first; n < last; n++) writeColor(n, job->color);
+        }
+        if (job->elapsed >= job->frames) {
+            for (n = job->first; n < last; n++) writeColor(n, paletteBase[n]);
+            job->type = PALETTE_JOB_NONE;
+        }
+        return;
+    }
+    
+    // Une division par job et par frame, le reste en multiplications
+    t = (job->elapsed >= job->frames) ? 256 : ((u16)job->elapsed << 8) / job->frames;
+    
+    for (n = job->first; n < last; n++) {
+        u16 to = (job->type == PALETTE_JOB_CROSS) ? paletteBase[n] : job->color;
+        
+        writeColor(n, blendColor(paletteFrom[n], to, t));
+    }
+    
+    if (job->elapsed < job->frames) return;
+    
+    if (job->type == PALETTE_JOB_DIP) {
+        // Deuxième moitié : retour aux couleurs de repos
+        for (n = job->first; n < last; n++) paletteFrom[n] = paletteWork[n];
+        job->type = PALETTE_JOB_CROSS;
+        job->elapsed = 0;
+        return;
+    }
+    
+    job->type = PALETTE_JOB_NONE;
+}
+
+void updatePalettes(void) {
+    u8 i;
+    
+    for (i = 0; i < PALETTE_JOBS; i++) {
+        if (paletteJobs[i].type != PALETTE_JOB_NONE) stepJob(&paletteJobs[i]);
+    }
+    
+    // Une plage par ligne modifiée : quelques mots par frame pour un flash
+    for (i = 0; i < PALETTE_LINES; i++) {
+        u8 first = dirtyFirst[i];
+        
+        if (first == PALETTE_CLEAN) continue;
+        
+        if (!queueDMAJob(DMA_CRAM, &paletteWork[first], first * 2,
+                         dirtyLast[i] - first + 1, DMA_PRIORITY_HIGH, NULL)) {
+            continue;        // File pleine : nouvel essai à la frame suivante
+        }
+        dirtyFirst[i] = PALETTE_CLEAN;
+        dirtyLast[i] = PALETTE_CLEAN;
+    }
+}
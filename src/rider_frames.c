@@ -0,0 +1,166 @@
+/* rider_frames.c - Choix du zoom et envoi des frames de rider en VRAM */
+
+#include <genesis.h>
+#include "resources.h"
+#include "rider_frames.h"
+#include "dma_queue.h"
+#include "sprite_scaler.h"
+
+// Tilesets générés, [modèle][zoom] (ResComp, sans compression : copiés tels quels)
+static const TileSet* const riderFrameSets[RIDER_DESIGNS][RIDER_ZOOM_LEVELS] = {
+    { &bike0_zoom0, &bike0_zoom1, &bike0_zoom2, &bike0_zoom3 },
+    { &bike1_zoom0, &bike1_zoom1, &bike1_zoom2, &bike1_zoom3 }
+};
+
+// Côté de chaque zoom en tuiles, et échelle de strip (8.8) à partir de
+// laquelle il est choisi : milieu entre deux tailles successives
+static const u8 riderZoomTiles[RIDER_ZOOM_LEVELS] = { 4, 3, 2, 1 };
+static const u16 riderZoomMinScale[RIDER_ZOOM_LEVELS] = { 224, 160, 96, 0 };
+
+// Niveau d'une zone : zoom pré-calculé, ou taille du réducteur logiciel
+#define RIDER_LEVEL_SOFT(bucket) (0x80 | (bucket))
+
+// Contenu actuel de chaque zone (RIDER_FRAME_NONE = à recharger)
+typedef struct {
+    u8 design;
+    u8 level;
+    u8 frame;
+    u8 size;                 // Côté affiché (pixels)
+} RiderFrameKey;
+
+_Static_assert(RIDER_FRAME_SLOTS <= 32, "rider_frames.c: frameSlotsUsed limité à 32 zones");
+
+static RiderFrameKey loadedFrames[RIDER_FRAME_SLOTS];
+static u32 frameSlotsUsed = 0;     // Bit n : zone n attribuée
+
+#if RIDER_SOFT_SCALE
+// Tampons de réduction : relus par le DMA au vblank, peut-être plusieurs
+// vblanks plus tard si le job est reporté. Un tampon n'est réutilisé
+// qu'une fois son job parti (drapeau tenu par la file de DMA)
+static u32 scaleStaging[RIDER_SCALES_PER_FRAME][SCALER_FRAME_LONGS];
+static volatile u8 scaleStagingBusy[RIDER_SCALES_PER_FRAME];
+static u8 scaleBudget = 0;
+#endif
+
+void initRiderFrames(void) {
+    u8 i;
+    
+    for (i = 0; i < RIDER_FRAME_SLOTS; i++) {
+        loadedFrames[i].frame = RIDER_FRAME_NONE;
+    }
+    frameSlotsUsed = 0;
+
+#if RIDER_SOFT_SCALE
+    initSpriteScaler();
+#endif
+}
+
+void beginRiderFrames(void) {
+#if RIDER_SOFT_SCALE
+    scaleBudget = RIDER_SCALES_PER_FRAME;
+#endif
+}
+
+u8 allocRiderFrameSlot(void) {
+    u8 slot;
+    
+    for (slot = 0; slot < RIDER_FRAME_SLOTS; slot++) {
+        if (!(frameSlotsUsed & (1UL << slot))) {
+            frameSlotsUsed |= 1UL << slot;
+            loadedFrames[slot].frame = RIDER_FRAME_NONE;
+            return slot;
+        }
+    }
+    
+    return RIDER_FRAME_NONE;
+}
+
+void freeRiderFrameSlot(u8 slot) {
+    if (slot >= RIDER_FRAME_SLOTS) return;
+    
+    frameSlotsUsed &= ~(1UL << slot);
+}
+
+u8 getRiderZoom(u16 scale) {
+    u8 zoom = 0;
+    
+    while (scale < riderZoomMinScale[zoom]) zoom++;
+    
+    return zoom;
+}
+
+#if RIDER_SOFT_SCALE
+static s8 findScaleStaging(void) {
+    s8 i;
+    
+    for (i = 0; i < RIDER_SCALES_PER_FRAME; i++) {
+        if (!scaleStagingBusy[i]) return i;
+    }
+    
+    return -1;
+}
+#endif
+
+static bool isLoaded(const RiderFrameKey* loaded, u8 design, u8 level, u8 frame) {
+    return loaded->frame == frame && loaded->level == level && loaded->design == design;
+}
+
+u8 updateRiderFrame(u8 slot, u8 design, u16 scale, u8 frame) {
+    RiderFrameKey* loaded = &loadedFrames[slot];
+    u8 zoom = getRiderZoom(scale);
+
+#if RIDER_SOFT_SCALE
+    // Riders proches : taille au pas de 2 pixels, réduite depuis la frame pleine
+    if (scale >= RIDER_SOFT_MIN_SCALE) {
+        u8 bucket = getScalerBucket(scale);
+        u8 level = RIDER_LEVEL_SOFT(bucket);
+        
+        if (isLoaded(loaded, design, level, frame)) return loaded->size;
+        
+        s8 index = (scaleBudget > 0) ? findScaleStaging() : -1;
+        
+        if (index >= 0) {
+            u32* staging = scaleStaging[index];
+            u8 size = SCALER_BUCKET_SIZE(bucket);
+            u8 tiles = (size + 7) >> 3;
+            const TileSet* full = riderFrameSets[design][0];
+            
+            scaleBudget--;
+            scaleSpriteFrame(full->tiles + frame * SCALER_FRAME_LONGS, staging, bucket);
+            
+            if (queueDMAJob(DMA_VRAM, staging, RIDER_SLOT_TILE(slot) * 32, tiles * tiles * 16,
+                            DMA_PRIORITY_NORMAL, &scaleStagingBusy[index])) {
+                loaded->design = design;
+                loaded->level = level;
+                loaded->frame = frame;
+                loaded->size = size;
+                return size;
+            }
+        }
+        
+        // Budget épuisé ou tampons encore en file : l'image en place reste
+        // affichée une frame de plus
+        if (loaded->frame != RIDER_FRAME_NONE) return loaded->size;
+    }
+#endif
+
+    // Frame pré-zoomée, envoyée seulement si elle a changé
+    if (!isLoaded(loaded, design, zoom, frame)) {
+        const TileSet* set = riderFrameSets[design][zoom];
+        u16 tiles = riderZoomTiles[zoom] * riderZoomTiles[zoom];
+        
+        // 8 mots longs par tuile ; longueur du DMA en mots. File pleine :
+        // nouvel essai à la frame suivante
+        if (!queueDMAJob(DMA_VRAM, set->tiles + frame * tiles * 8,
+                         RIDER_SLOT_TILE(slot) * 32, tiles * 16, DMA_PRIORITY_NORMAL, NULL)) {
+            return (loaded->frame != RIDER_FRAME_NONE) ? loaded->size : 0;
+        }
+        
+        loaded->design = design;
+        loaded->level = zoom;
+        loaded->frame = frame;
+        loaded->size = riderZoomTiles[zoom] << 3;
+    }
+    
+    return loaded->size;
+}
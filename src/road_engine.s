@@ -1,191 +1,180 @@
 /* road_engine.s - Routines assembleur optimisées pour le rendu pseudo-3D */
 
+#include "vram_layout.h"
+
 .text
 
-/* Constantes VDP */
+/* Constantes VDP (adresses VRAM : vram_layout.h) */
 VDP_CTRL = 0xC00004
 VDP_DATA = 0xC00000
-PLAN_A_BASE = 0xC000
-TILE_USER_INDEX = 0x0001
+PLAN_A_BASE = VRAM_PLANE_A
 
-/* Attributs des tuiles */
-TILE_ROAD = TILE_USER_INDEX
-TILE_GRASS = TILE_USER_INDEX + 8
+/* Attributs des tuiles : première tuile des banques route et herbe */
+TILE_ROAD = VRAM_ROAD_TILE
+TILE_GRASS = VRAM_GRASS_TILE
 PAL0_ATTR = 0x0000
 PAL1_ATTR = 0x2000
 
 .global renderRoadStripsASM
 .global clearPlanA
 
+/* Géométrie (voir tools/road_ref/road_ref.h, modèle de référence C) */
+SCREEN_COLS = 40
+SCREEN_H = 224
+HORIZON_Y = 80
+CENTER_X = 160
+PLANE_ROW_BYTES = 128           /* 64 cellules * 2 octets */
+
+/* Commande VDP écriture VRAM pour PLAN_A_BASE (bits A15-A14 dans le mot bas) */
+VRAM_WRITE_PLAN_A = 0x40000000 | (PLAN_A_BASE >> 14)
+
 /*
  * Fonction: renderRoadStripsASM
- * Paramètres: 
- *   a0 = pointeur vers tableau RoadStrip
- *   d0 = nombre de strips
+ * void renderRoadStripsASM(RoadStrip* strips, u16 numStrips)
+ * Paramètres (pile, ABI m68k-elf GCC):
+ *   4(sp) = pointeur vers tableau RoadStrip
+ *   8(sp) = nombre de strips (u16 promu en long)
+ *
+ * Chaque strip visible réécrit les 40 cellules de sa ligne de tuiles :
+ * herbe à gauche, route entre les bords, herbe à droite. L'adresse VRAM
+ * est positionnée une seule fois par ligne puis l'auto-incrément (2)
+ * enchaîne les écritures. Spécification : roadRefRender() (tools/road_ref/road_ref.c).
+ *
+ * Registres:
+ *   a0 = strip courant, a2 = VDP_DATA, a3 = VDP_CTRL
+ *   d7 = compteur de strips (dbra), d4 = mot herbe, d5 = mot route
  */
 renderRoadStripsASM:
-    movem.l d1-d7/a1-a6, -(sp)  /* Sauvegarde des registres */
-    
-    move.w d0, d7               /* d7 = compteur de strips */
+    movem.l d2-d7/a2-a3, -(sp)  /* 8 registres = 32 octets */
+
+    move.l 36(sp), a0           /* a0 = strips */
+    move.w 42(sp), d7           /* d7 = numStrips (mot bas du long) */
     subq.w #1, d7               /* Ajustement pour dbra */
-    
+    bmi render_done
+
+    lea VDP_DATA, a2
+    lea VDP_CTRL, a3
+    move.w #0x8F02, (a3)        /* Auto-incrément VDP = 2 */
+    move.w #(TILE_GRASS | PAL0_ATTR), d4
+    move.w #(TILE_ROAD | PAL0_ATTR), d5
+
 render_loop:
-    /* Récupération des données du strip actuel */
-    move.w 0(a0), d1            /* d1 = screenY */
-    move.w 2(a0), d2            /* d2 = roadWidth */
-    move.w 4(a0), d3            /* d3 = roadXOffset */
-    move.w 6(a0), d4            /* d4 = scale */
-    
     /* Vérification si on est dans la zone visible */
-    cmp.w #224, d1
-    bge next_strip
-    cmp.w #80, d1               /* Horizon Y */
-    blt next_strip
-    
-    /* Calcul de la position centrale de la route */
-    move.w #160, d5             /* Centre écran */
-    add.w d3, d5                /* + offset de courbure */
-    
-    /* Calcul des bords de la route */
-    move.w d5, d6
-    sub.w d2, d6                /* Bord gauche */
-    asr.w #1, d6                /* /2 car roadWidth est le diamètre */
-    
-    move.w d5, d7
-    add.w d2, d7                /* Bord droit */
-    asr.w #1, d7                /* /2 */
-    
-    /* Conversion en coordonnées tuiles */
-    asr.w #4, d6                /* /16 pour tuiles */
-    move.w d7, d0
-    asr.w #4, d0                /* /16 pour tuiles */
-    
+    move.w (a0), d0             /* d0 = screenY */
+    cmp.w #SCREEN_H, d0
+    bge.s next_strip
+    cmp.w #HORIZON_Y, d0
+    blt.s next_strip
+
+    /* Bords de la route en pixels : centre ± roadWidth/2 */
+    move.w 2(a0), d1            /* d1 = roadWidth (diamètre) */
+    lsr.w #1, d1                /* d1 = demi-largeur */
+    move.w 4(a0), d2            /* d2 = roadXOffset */
+    add.w #CENTER_X, d2         /* d2 = centre */
+    move.w d2, d3
+    sub.w d1, d3                /* d3 = bord gauche */
+    add.w d1, d2                /* d2 = bord droit */
+
+    /* Conversion en colonnes de tuiles (8 pixels) */
+    asr.w #3, d3
+    asr.w #3, d2
+
     /* Limitation aux bords de l'écran */
-    tst.w d6
+    tst.w d3
     bpl.s check_right
-    moveq #0, d6
+    moveq #0, d3
 check_right:
-    cmp.w #39, d0               /* 320/8 = 40 tuiles max */
-    ble.s draw_scanline
-    move.w #39, d0
-    
-draw_scanline:
-    /* Dessiner la ligne courante */
-    move.w d1, d5               /* Y en coordonnées tuiles */
-    asr.w #3, d5                /* /8 pour tuiles */
-    
-    /* Dessiner l'herbe à gauche */
-    moveq #0, d2                /* X = 0 */
+    cmp.w #SCREEN_COLS - 1, d2
+    ble.s count_cells
+    moveq #SCREEN_COLS - 1, d2
+
+count_cells:
+    /* d3 = herbe gauche, d1 = route, d6 = herbe droite (total 40) */
+    cmp.w #SCREEN_COLS, d3
+    ble.s count_road
+    moveq #SCREEN_COLS, d3
+count_road:
+    move.w d2, d1
+    sub.w d3, d1
+    addq.w #1, d1               /* d1 = droite - gauche + 1 */
+    bpl.s count_right
+    moveq #0, d1
+count_right:
+    moveq #SCREEN_COLS, d6
+    sub.w d3, d6
+    sub.w d1, d6
+
+    /* Adresse VRAM de la ligne : PLAN_A_BASE + (screenY / 8) * 128 */
+    andi.w #0xFFF8, d0          /* (screenY / 8) * 8 */
+    lsl.w #4, d0                /* * 16 = ligne * 128 (< 0x1000) */
+    swap d0
+    clr.w d0
+    ori.l #VRAM_WRITE_PLAN_A, d0
+    move.l d0, (a3)
+
+    /* Herbe à gauche */
+    subq.w #1, d3
+    bmi.s draw_road
 grass_left_loop:
-    cmp.w d6, d2
-    bge.s draw_road_section
-    
-    /* Calcul adresse VRAM pour PLAN_A */
-    move.w d5, d4               /* Y */
-    lsl.w #6, d4                /* * 64 (largeur plan) */
-    add.w a2, d4                /* + X */
-    lsl.w #1, d4                /* * 2 (mots) */
-    add.w #PLAN_A_BASE, d4
-    
-    /* Configuration DMA pour l'herbe */
-    move.l #((2 << 30) | (0x8F01) | (0x9300) | (0x9400)), VDP_CTRL  /* Commande DMA + incrément 1 */
-    move.l #((0x40000000) | (PLAN_A_BASE + (d5 * 128) + (d2 * 2))), VDP_CTRL /* Adresse VRAM */
-    move.w #(TILE_GRASS | PAL0_ATTR), VDP_DATA
-    
-    addq.w #1, a2
-    bra.s grass_left_loop
-    
-draw_road_section:
-    /* Dessiner la section de route */
-    move.w d6, a2               /* X début route */
+    move.w d4, (a2)
+    dbra d3, grass_left_loop
+
+draw_road:
+    /* Section de route */
+    subq.w #1, d1
+    bmi.s draw_grass_right
 road_loop:
-    cmp.w d0, a2                /* X fin route */
-    bgt.s draw_grass_right
-    
-    /* Calcul adresse VRAM */
-    move.w d5, d4               /* Y */
-    lsl.w #6, d4                /* * 64 */
-    add.w a2, d4                /* + X */
-    lsl.w #1, d4                /* * 2 */
-    add.w #PLAN_A_BASE, d4
-    
-    /* Configuration DMA pour la route */
-    move.l #((2 << 30) | (0x8F01) | (0x9300) | (0x9400)), VDP_CTRL  /* Commande DMA + incrément 1 */
-    move.l #((0x40000000) | (PLAN_A_BASE + (d5 * 128) + (a2 * 2))), VDP_CTRL /* Adresse VRAM */
-    move.w #(TILE_ROAD | PAL0_ATTR), VDP_DATA
-    
-    addq.w #1, a2
-    bra.s road_loop
-    
+    move.w d5, (a2)
+    dbra d1, road_loop
+
 draw_grass_right:
-    /* Dessiner l'herbe à droite */
-    move.w d0, a2               /* X fin route */
-    addq.w #1, a2               /* X début herbe droite */
+    /* Herbe à droite */
+    subq.w #1, d6
+    bmi.s next_strip
 grass_right_loop:
-    cmp.w #40, a2               /* Largeur écran */
-    bge.s next_strip
-    
-    /* Calcul adresse VRAM */
-    move.w d5, d4               /* Y */
-    lsl.w #6, d4                /* * 64 */
-    add.w a2, d4                /* + X */
-    lsl.w #1, d4                /* * 2 */
-    add.w #PLAN_A_BASE, d4
-    
-    /* Configuration DMA pour l'herbe */
-    move.l #((2 << 30) | (0x8F01) | (0x9300) | (0x9400)), VDP_CTRL  /* Commande DMA + incrément 1 */
-    move.l #((0x40000000) | (PLAN_A_BASE + (d5 * 128) + (a2 * 2))), VDP_CTRL /* Adresse VRAM */
-    move.w #(TILE_GRASS | PAL0_ATTR), VDP_DATA
-    
-    addq.w #1, a2
-    bra.s grass_right_loop
-    
+    move.w d4, (a2)
+    dbra d6, grass_right_loop
+
 next_strip:
-    lea 8(a0), a0               /* Strip suivant (8 octets) */
+    addq.l #8, a0               /* Strip suivant (8 octets) */
     dbra d7, render_loop        /* Décrémenter et boucler */
-    
-    movem.l (sp)+, d1-d7/a1-a6  /* Restauration des registres */
+
+render_done:
+    movem.l (sp)+, d2-d7/a2-a3  /* Restauration des registres */
     rts
 
 /*
  * Fonction: clearPlanA
- * Efface rapidement le plan A (zone route)
+ * void clearPlanA(void)
+ * Efface rapidement le plan A (zone route, lignes de tuiles 10 à 27).
+ * Spécification : roadRefClearPlanA() (tools/road_ref/road_ref.c).
  */
+CLEAR_FIRST_ROW = 10
+CLEAR_ROWS = 18
+
 clearPlanA:
-    movem.l d0-d2/a0, -(sp)
-    
-    /* Configuration pour effacer la zone route (lignes 10-28) */
-    move.w #18, d0              /* 18 lignes à effacer */
-    subq.w #1, d0               /* Pour dbra */
-    
-    move.w #10, d1              /* Y début */
-    
+    movem.l d2-d3, -(sp)
+
+    lea VDP_DATA, a0
+    lea VDP_CTRL, a1
+    move.w #0x8F02, (a1)        /* Auto-incrément VDP = 2 */
+
+    /* d0 = commande VRAM de la première ligne, d2 = pas d'une ligne */
+    move.l #VRAM_WRITE_PLAN_A | ((CLEAR_FIRST_ROW * PLANE_ROW_BYTES) << 16), d0
+    move.l #PLANE_ROW_BYTES << 16, d2
+    moveq #0, d3                /* Tuile 0 = vide */
+    moveq #CLEAR_ROWS - 1, d1   /* Compteur de lignes pour dbra */
+
 clear_line_loop:
-    move.w #39, d2              /* 40 tuiles par ligne */
-    subq.w #1, d2               /* Pour dbra */
-    moveq #0, d0                /* X début */
-    
-clear_tile_loop:
-    /* Calcul adresse VRAM */
-    move.w d1, d3               /* Y */
-    lsl.w #6, d3                /* * 64 */
-    add.w d0, d3                /* + X */
-    lsl.w #1, d3                /* * 2 */
-    add.w #PLAN_A_BASE, d3
-    
-    /* Écriture tuile vide */
-    move.l d3, d4
-    ori.l #0x40000000, d4
-    move.l d4, VDP_CTRL
-    move.w #0, VDP_DATA         /* Tuile 0 = vide */
-    
-    addq.w #1, a0
-    dbra d2, clear_tile_loop
-    
-    addq.w #1, d1
-    dbra d0, clear_line_loop
-    
-    movem.l (sp)+, d0-d2/a0
+    move.l d0, (a1)
+    /* 40 tuiles vides = 20 écritures long (pas de clr : lecture parasite du port) */
+    .rept SCREEN_COLS / 2
+    move.l d3, (a0)
+    .endr
+    add.l d2, d0
+    dbra d1, clear_line_loop
+
+    movem.l (sp)+, d2-d3
     rts
 
 /*
@@ -199,7 +188,7 @@ setHorizontalScroll:
     /* Calcul adresse scroll horizontal */
     move.w d0, d2               /* Line */
     lsl.w #2, d2                /* * 4 (PLAN_A + PLAN_B) */
-    add.w #0xFC00, d2           /* Base adresse H-scroll */
+    add.w #VRAM_HSCROLL, d2     /* Base adresse H-scroll */
     
     /* Écriture offset */
     move.l d2, d3
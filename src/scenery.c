@@ -0,0 +1,205 @@
+/* scenery.c - Objets de bord de route : flux, anneau, projection et sprites */
+
+#include <genesis.h>
+#include "resources.h"
+#include "scenery.h"
+#include "road.h"
+#include "sprites.h"
+#include "rider_frames.h"
+#include "dma_queue.h"
+#include "vram_layout.h"
+
+#define SCENERY_SCREEN_WIDTH 320
+#define SCENERY_BANDS        (SCREEN_HEIGHT >> 3)
+
+// Mêmes niveaux de zoom que les frames de rider (getRiderZoom)
+static const TileSet* const sceneryFrameSets[RIDER_ZOOM_LEVELS] = {
+    &scenery_zoom0, &scenery_zoom1, &scenery_zoom2, &scenery_zoom3
+};
+static const u8 sceneryZoomTiles[RIDER_ZOOM_LEVELS] = { 4, 3, 2, 1 };
+
+// Écart au centre de la route par type, en pixels à l'échelle 256 (bord
+// de la route : ROAD_BASE_WIDTH / 2)
+static const s16 sceneryOffset[SCENERY_TYPES] = {
+    124,                     // Arbre : en retrait
+    104,                     // Panneau
+    88,                      // Poteau : sur le bord
+    0, 0, 0                  // Entités : placées par renderAIRiders
+};
+
+typedef struct {
+    const SceneryObject* object;
+    u8 sprite;
+} SceneryEntry;
+
+u8 sceneryDrawn = 0;
+
+// Anneau trié par position : ringHead est le plus proche, le suivant à retirer
+static SceneryEntry sceneryRing[SCENERY_RING];
+static u8 ringHead = 0;
+static u8 ringCount = 0;
+
+static const SceneryObject* sceneryStream = NULL;
+static const SceneryObject* streamCursor = NULL;
+static s32 lastPosition = 0;
+
+// Première tuile de chaque zoom dans la banque VRAM_SCENERY_TILE
+static u16 sceneryZoomTile[RIDER_ZOOM_LEVELS];
+
+void initScenery(const SceneryObject* stream) {
+    u16 tile = 0;
+    u8 zoom;
+    
+    sceneryStream = stream;
+    
+    // Tous les zooms dans la banque, en transfert de fond découpé au budget
+    for (zoom = 0; zoom < RIDER_ZOOM_LEVELS; zoom++) {
+        const TileSet* set = sceneryFrameSets[zoom];
+        
+        sceneryZoomTile[zoom] = tile;
+        if (tile + set->numTile > VRAM_SCENERY_TILES) {
+            sceneryStream = NULL;        // Banque trop petite : pas de décor
+            break;
+        }
+        
+        queueDMAJob(DMA_VRAM, set->tiles, (VRAM_SCENERY_TILE + tile) * VRAM_TILE_BYTES,
+                    set->numTile * (VRAM_TILE_BYTES / 2), DMA_PRIORITY_LOW, NULL);
+        tile += set->numTile;
+    }
+    
+    resetScenery();
+}
+
+void resetScenery(void) {
+    while (ringCount > 0) {
+        if (sceneryRing[ringHead].sprite != SPRITE_NONE) freeSpriteSlot(sceneryRing[ringHead].sprite);
+        if (++ringHead >= SCENERY_RING) ringHead = 0;
+        ringCount--;
+    }
+    
+    ringHead = 0;
+    streamCursor = sceneryStream;
+    lastPosition = 0;
+    sceneryDrawn = 0;
+}
+
+static SceneryEntry* ringEntry(u8 n) {
+    u8 index = ringHead + n;
+    
+    if (index >= SCENERY_RING) index -= SCENERY_RING;
+    return &sceneryRing[index];
+}
+
+static void hideEntry(SceneryEntry* entry) {
+    if (entry->sprite != SPRITE_NONE) hideSpriteSlot(entry->sprite);
+}
+
+u16 getSceneryFrame(u8 type, u16 scale, u8* tiles) {
+    u8 zoom = getRiderZoom(scale);
+    
+    *tiles = sceneryZoomTiles[zoom];
+    return VRAM_SCENERY_TILE + sceneryZoomTile[zoom] + type * *tiles * *tiles;
+}
+
+void updateScenery(s32 trackPosition) {
+    u8 bandCount[SCENERY_BANDS];
+    s16 s = roadStripCount - 1;
+    u8 n;
+    
+    if (!sceneryStream) return;
+    
+    // Retour au départ (niveau suivant, game over) : flux repris au début
+    if (trackPosition < lastPosition) resetScenery();
+    lastPosition = trackPosition;
+    
+    // Objets dépassés : toujours en tête de l'anneau
+    while (ringCount > 0 && ringEntry(0)->object->position < trackPosition) {
+        SceneryEntry* entry = ringEntry(0);
+        
+        if (entry->sprite != SPRITE_NONE) freeSpriteSlot(entry->sprite);
+        if (++ringHead >= SCENERY_RING) ringHead = 0;
+        ringCount--;
+    }
+    
+    // Objets qui entrent dans la distance d'affichage, dans l'ordre du flux
+    while (streamCursor->position != SCENERY_END &&
+           streamCursor->position <= trackPosition + SCENERY_DRAW_DISTANCE &&
+           ringCount < SCENERY_RING) {
+        if (streamCursor->position >= trackPosition) {
+            SceneryEntry* entry = ringEntry(ringCount++);
+            
+            entry->object = streamCursor;
+            entry->sprite = SPRITE_NONE;
+        }
+        streamCursor++;
+    }
+    
+    for (n = 0; n < SCENERY_BANDS; n++) {
+        bandCount[n] = 0;
+    }
+    sceneryDrawn = 0;
+    
+    // Du plus proche au plus loin : les plafonds écartent d'abord les
+    // objets lointains. Strips parcourus en sens inverse, conjointement
+    for (n = 0; n < ringCount; n++) {
+        SceneryEntry* entry = ringEntry(n);
+        const SceneryObject* object = entry->object;
+        s32 depth = (s32)(object->position - trackPosition) << ROAD_DEPTH_SHIFT;
+        
+        while (s > 0 && roadStripDepth[s - 1] <= depth) s--;
+        
+        if (s < 0 || roadStripDepth[s] > depth || sceneryDrawn >= SCENERY_MAX_SPRITES) {
+            hideEntry(entry);
+            continue;
+        }
+        
+        const RoadStrip* strip = &roadStrips[s];
+        
+        if (strip->scale < SCENERY_MIN_SCALE) {
+            hideEntry(entry);
+            continue;
+        }
+        
+        u8 tiles;
+        u16 tile = getSceneryFrame(object->type, strip->scale, &tiles);
+        s16 size = tiles << 3;
+        s16 x = ROAD_CENTER_X + strip->roadXOffset +
+                object->side * ((sceneryOffset[object->type] * strip->scale) >> 8) - (size >> 1);
+        s16 y = strip->screenY - size;
+        
+        if (x >= SCENERY_SCREEN_WIDTH || x + size <= 0) {
+            hideEntry(entry);
+            continue;
+        }
+        
+        // Plafond par ligne, par bandes de 8 lignes comme sprites.c
+        s16 first = (y < 0) ? 0 : y >> 3;
+        s16 last = (strip->screenY - 1) >> 3;
+        s16 band;
+        bool fits = TRUE;
+        
+        if (last >= SCENERY_BANDS) last = SCENERY_BANDS - 1;
+        for (band = first; band <= last; band++) {
+            if (bandCount[band] >= SCENERY_PER_LINE) {
+                fits = FALSE;
+                break;
+            }
+        }
+        if (!fits) {
+            hideEntry(entry);
+            continue;
+        }
+        
+        if (entry->sprite == SPRITE_NONE) {
+            entry->sprite = allocSpriteSlot();
+            if (entry->sprite == SPRITE_NONE) continue;
+        }
+        
+        for (band = first; band <= last; band++) bandCount[band]++;
+        
+        placeSpriteSlot(entry->sprite, x, y,
+                        TILE_ATTR_FULL(PAL1, 0, FALSE, FALSE, tile),
+                        SPRITE_SIZE(tiles, tiles), object->position - trackPosition);
+        sceneryDrawn++;
+    }
+}
@@ -0,0 +1,75 @@
+/* sprite_scaler.c - Réduction de frames de sprite 4bpp au format tuile */
+
+#include <genesis.h>
+#include "sprite_scaler.h"
+
+// Pixel source (0-31) de chaque ligne ou colonne de sortie, par taille
+static u8 scalerSkip[SCALER_BUCKETS][SCALER_SOURCE_SIZE];
+
+void initSpriteScaler(void) {
+    u8 bucket, i;
+    
+    for (bucket = 0; bucket < SCALER_BUCKETS; bucket++) {
+        u8 size = SCALER_BUCKET_SIZE(bucket);
+        
+        for (i = 0; i < SCALER_SOURCE_SIZE; i++) {
+            scalerSkip[bucket][i] = (i < size) ? (i * SCALER_SOURCE_SIZE) / size : 0;
+        }
+    }
+}
+
+u8 getScalerBucket(u16 scale) {
+    // Taille de sortie = 32 * scale (8.8), arrondie au pas de 2 pixels
+    u16 size = (SCALER_SOURCE_SIZE * scale + 256) >> 8;
+    
+    if (size < SCALER_MIN_SIZE) size = SCALER_MIN_SIZE;
+    if (size > SCALER_SOURCE_SIZE) size = SCALER_SOURCE_SIZE;
+    
+    return (size - SCALER_MIN_SIZE) >> 1;
+}
+
+void scaleSpriteFrame(const u32* source, u32* dest, u8 bucket) {
+    const u8* skip = scalerSkip[bucket];
+    u8 size = SCALER_BUCKET_SIZE(bucket);
+    u8 tiles = (size + 7) >> 3;
+    u16 columnStride = tiles << 3;           // Longs entre deux colonnes de tuiles
+    u8 y, tx, px;
+    
+    for (y = 0; y < (tiles << 3); y++) {
+        u32* out = dest + ((y >> 3) << 3) + (y & 7);
+        
+        // Sous la frame : transparent
+        if (y >= size) {
+            for (tx = 0; tx < tiles; tx++) out[tx * columnStride] = 0;
+            continue;
+        }
+        
+        // Réduction seulement (size <= SCALER_SOURCE_SIZE) : chaque ligne de
+        // sortie lit une ligne source différente
+        u8 sy = skip[y];
+        
+        // Les 4 mots longs de la ligne source (un par colonne de tuiles)
+        const u32* row = source + ((sy >> 3) << 3) + (sy & 7);
+        u32 line[SCALER_SOURCE_TILES];
+        
+        for (tx = 0; tx < SCALER_SOURCE_TILES; tx++) {
+            line[tx] = row[tx * (SCALER_SOURCE_TILES << 3)];
+        }
+        
+        // Un nibble par pixel de sortie, colonne source lue dans la table
+        for (tx = 0; tx < tiles; tx++) {
+            u32 word = 0;
+            u8 x = tx << 3;
+            
+            for (px = 0; px < 8; px++, x++) {
+                word <<= 4;
+                if (x < size) {
+                    u8 sx = skip[x];
+                    word |= (line[sx >> 3] >> ((7 - (sx & 7)) << 2)) & 0xF;
+                }
+            }
+            
+            out[tx * columnStride] = word;
+        }
+    }
+}
@@ -0,0 +1,229 @@
+/* sprites.c - SAT en RAM : tri en profondeur, limite par ligne, file de DMA */
+
+#include <genesis.h>
+#include "sprites.h"
+#include "dma_queue.h"
+#include "vram_layout.h"
+
+#define SAT_SCREEN_WIDTH   320
+#define SAT_SCREEN_HEIGHT  224
+#define SAT_COORD_OFFSET   128     // Origine des coordonnées de la SAT
+#define SAT_BAND_SHIFT     3       // Comptage par bandes de 8 lignes
+#define SAT_BANDS          (SAT_SCREEN_HEIGHT >> SAT_BAND_SHIFT)
+
+// Entrée de la SAT, format matériel (4 mots)
+typedef struct {
+    s16 y;
+    u16 sizeLink;            // Taille (bits 11-8) et index suivant (bits 6-0)
+    u16 attr;
+    s16 x;
+} SatEntry;
+
+SpriteSlot spriteSlots[SPRITE_SLOTS];
+u8 spriteDeferred = 0;
+
+// Emplacements alloués, triés par profondeur croissante (le premier est
+// affiché au-dessus des autres et servi en premier par le VDP sur sa ligne)
+static u8 spriteOrder[SPRITE_SLOTS];
+static u8 spriteOrderCount = 0;
+static u8 spriteFreeHead = SPRITE_NONE;
+
+// Relue par le DMA au vblank qui suit sa mise en file : le job est de
+// priorité haute, donc jamais reporté, et la table suivante n'est
+// construite qu'après ce vblank
+static SatEntry satShadow[SAT_ENTRIES];
+static u16 satCount = 1;
+
+// Premier sprite servi lors de la sélection : avance à chaque frame saturée
+// pour que les sprites écartés changent d'une frame à l'autre
+static u8 spriteRotation = 0;
+
+static void queueSpriteTable(void) {
+    // Un seul DMA, de taille proportionnelle aux sprites affichés. Mise en
+    // file seulement une fois la table complète : un vblank tombé pendant
+    // la construction ne voit pas de table à moitié écrite
+    queueDMAJob(DMA_VRAM, satShadow, VRAM_SPRITE_TABLE,
+                satCount * (sizeof(SatEntry) / 2), DMA_PRIORITY_HIGH, NULL);
+}
+
+void initSpriteManager(void) {
+    u8 i;
+    
+    for (i = 0; i < SPRITE_SLOTS; i++) {
+        spriteSlots[i].visible = FALSE;
+        spriteSlots[i].next = (i + 1 < SPRITE_SLOTS) ? i + 1 : SPRITE_NONE;
+    }
+    spriteFreeHead = 0;
+    spriteOrderCount = 0;
+    spriteRotation = 0;
+    
+    // Table vide : une seule entrée hors écran
+    satShadow[0].y = 0;
+    satShadow[0].sizeLink = 0;
+    satShadow[0].attr = 0;
+    satShadow[0].x = 0;
+    satCount = 1;
+    queueSpriteTable();
+}
+
+u8 allocSpriteSlot(void) {
+    u8 slot = spriteFreeHead;
+    
+    if (slot == SPRITE_NONE) return SPRITE_NONE;
+    
+    spriteFreeHead = spriteSlots[slot].next;
+    spriteSlots[slot].visible = FALSE;
+    spriteSlots[slot].depth = 0xFFFF;
+    
+    // En queue de l'ordre, remis en place par le tri de buildSpriteTable
+    spriteOrder[spriteOrderCount++] = slot;
+    
+    return slot;
+}
+
+void freeSpriteSlot(u8 slot) {
+    u8 n;
+    
+    if (slot >= SPRITE_SLOTS) return;
+    
+    for (n = 0; n < spriteOrderCount; n++) {
+        if (spriteOrder[n] == slot) {
+            spriteOrderCount--;
+            for (; n < spriteOrderCount; n++) {
+                spriteOrder[n] = spriteOrder[n + 1];
+            }
+            break;
+        }
+    }
+    
+    spriteSlots[slot].visible = FALSE;
+    spriteSlots[slot].next = spriteFreeHead;
+    spriteFreeHead = slot;
+}
+
+void placeSpriteSlot(u8 slot, s16 x, s16 y, u16 attr, u8 size, u16 depth) {
+    SpriteSlot* sprite = &spriteSlots[slot];
+    
+    sprite->x = x;
+    sprite->y = y;
+    sprite->attr = attr;
+    sprite->size = size;
+    sprite->depth = depth;
+    sprite->visible = TRUE;
+}
+
+void hideSpriteSlot(u8 slot) {
+    spriteSlots[slot].visible = FALSE;
+}
+
+static void writeSatEntry(u16 index, const SpriteSlot* sprite) {
+    SatEntry* entry = &satShadow[index];
+    
+    entry->y = sprite->y + SAT_COORD_OFFSET;
+    entry->sizeLink = ((u16)sprite->size << 8) | (index + 1);
+    entry->attr = sprite->attr;
+    entry->x = sprite->x + SAT_COORD_OFFSET;
+}
+
+void buildSpriteTable(void) {
+    u8 bandCount[SAT_BANDS];
+    u8 onScreen[SPRITE_SLOTS];
+    u8 keep[SPRITE_SLOTS];
+    u8 count = 0;
+    u8 n, k, start;
+    
+    // Tri par insertion : O(n) quand l'ordre n'a pas changé
+    for (n = 1; n < spriteOrderCount; n++) {
+        u8 slot = spriteOrder[n];
+        u16 depth = spriteSlots[slot].depth;
+        
+        k = n;
+        while (k > 0 && spriteSlots[spriteOrder[k - 1]].depth > depth) {
+            spriteOrder[k] = spriteOrder[k - 1];
+            k--;
+        }
+        spriteOrder[k] = slot;
+    }
+    
+    // Sprites visibles et au moins en partie à l'écran, dans l'ordre de profondeur
+    for (n = 0; n < spriteOrderCount; n++) {
+        const SpriteSlot* sprite = &spriteSlots[spriteOrder[n]];
+        s16 width = ((sprite->size >> 2) + 1) << 3;
+        s16 height = ((sprite->size & 3) + 1) << 3;
+        
+        if (!sprite->visible) continue;
+        if (sprite->x >= SAT_SCREEN_WIDTH || sprite->x + width <= 0) continue;
+        if (sprite->y >= SAT_SCREEN_HEIGHT || sprite->y + height <= 0) continue;
+        
+        onScreen[count++] = spriteOrder[n];
+    }
+    
+    // Sélection : au plus SPRITES_PER_LINE par bande. Le départ tourne, donc
+    // sur une zone saturée ce ne sont pas toujours les mêmes qui sont écartés
+    for (n = 0; n < SAT_BANDS; n++) {
+        bandCount[n] = 0;
+    }
+    
+    start = (spriteRotation < count) ? spriteRotation : 0;
+    spriteDeferred = 0;
+    
+    for (n = 0; n < count; n++) {
+        u8 index = start + n;
+        if (index >= count) index -= count;
+        
+        const SpriteSlot* sprite = &spriteSlots[onScreen[index]];
+        s16 first = sprite->y >> SAT_BAND_SHIFT;
+        s16 last = (sprite->y + (((sprite->size & 3) + 1) << 3) - 1) >> SAT_BAND_SHIFT;
+        s16 band;
+        
+        if (first < 0) first = 0;
+        if (last >= SAT_BANDS) last = SAT_BANDS - 1;
+        
+        keep[index] = TRUE;
+        for (band = first; band <= last; band++) {
+            if (bandCount[band] >= SPRITES_PER_LINE) {
+                keep[index] = FALSE;
+                break;
+            }
+        }
+        
+        if (!keep[index]) {
+            spriteDeferred++;
+            continue;
+        }
+        
+        for (band = first; band <= last; band++) {
+            bandCount[band]++;
+        }
+    }
+    
+    spriteRotation = 0;
+    if (spriteDeferred) {
+        spriteRotation = start + spriteDeferred;
+        if (spriteRotation >= count) spriteRotation -= count;
+    }
+    
+    // Chaînage : retenus en ordre de profondeur, puis les écartés (le VDP ne
+    // les affiche que sur les lignes où il reste de la place)
+    satCount = 0;
+    for (n = 0; n < count; n++) {
+        if (keep[n]) writeSatEntry(satCount++, &spriteSlots[onScreen[n]]);
+    }
+    for (n = 0; n < count; n++) {
+        if (!keep[n]) writeSatEntry(satCount++, &spriteSlots[onScreen[n]]);
+    }
+    
+    if (satCount == 0) {
+        // Aucun sprite : une entrée hors écran
+        satShadow[0].y = 0;
+        satShadow[0].sizeLink = 0;
+        satShadow[0].attr = 0;
+        satShadow[0].x = 0;
+        satCount = 1;
+    }
+    
+    // Fin de chaîne
+    satShadow[satCount - 1].sizeLink &= 0xFF00;
+    
+    queueSpriteTable();
+}
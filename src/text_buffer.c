@@ -0,0 +1,168 @@
+/* text_buffer.c - Texte en RAM sur le plan B, cellules modifiées envoyées une fois par frame */
+
+#include <genesis.h>
+#include "text_buffer.h"
+#include "dma_queue.h"
+#include "vram_layout.h"
+
+#define TEXT_PLANE_WIDTH     64      // Cellules par ligne du plan (vram_layout.h)
+#define TEXT_CLEAN           0xFF
+#define TEXT_DIRTY_BYTES     ((TEXT_COLUMNS + 7) >> 3)
+#define TEXT_BLANK           0       // Tuile vide, comme VDP_clearText
+
+// Police SGDK en VRAM_FONT_TILE, à partir du caractère ' '
+#define TEXT_TILE(c)         TILE_ATTR_FULL(PAL0, TRUE, FALSE, FALSE, VRAM_FONT_TILE + (c) - 32)
+
+typedef struct {
+    u8 x;
+    u8 y;
+    u8 length;
+    u16 timer;               // 0 : entrée libre
+} TimedText;
+
+// Image de la zone de texte : chaque ligne est relue telle quelle par le DMA
+static u16 textMap[TEXT_ROWS][TEXT_COLUMNS];
+static u8 dirtyCells[TEXT_ROWS][TEXT_DIRTY_BYTES];  // Un bit par cellule modifiée
+static u8 dirtyFirst[TEXT_ROWS];                     // Première cellule modifiée
+static volatile u8 rowQueued[TEXT_ROWS];     // Jobs de la ligne encore en file
+static u8 flushRow = 0;                      // Départ tournant du flush
+
+static TimedText timedTexts[TEXT_TIMED_MESSAGES];
+
+void initTextBuffer(void) {
+    u8 x, y;
+    
+    // Plans vidés au démarrage : l'image part vide, rien à envoyer
+    for (y = 0; y < TEXT_ROWS; y++) {
+        for (x = 0; x < TEXT_COLUMNS; x++) {
+            textMap[y][x] = TEXT_BLANK;
+        }
+        for (x = 0; x < TEXT_DIRTY_BYTES; x++) {
+            dirtyCells[y][x] = 0;
+        }
+        dirtyFirst[y] = TEXT_CLEAN;
+        rowQueued[y] = FALSE;
+    }
+    flushRow = 0;
+    
+    for (x = 0; x < TEXT_TIMED_MESSAGES; x++) {
+        timedTexts[x].timer = 0;
+    }
+}
+
+void setBufferedTile(u8 x, u8 y, u16 tile) {
+    if (x >= TEXT_COLUMNS || y >= TEXT_ROWS) return;
+    if (textMap[y][x] == tile) return;
+    
+    textMap[y][x] = tile;
+    dirtyCells[y][x >> 3] |= 1 << (x & 7);
+    if (dirtyFirst[y] == TEXT_CLEAN || x < dirtyFirst[y]) dirtyFirst[y] = x;
+}
+
+void drawBufferedText(const char* text, u8 x, u8 y) {
+    for (; *text && x < TEXT_COLUMNS; text++, x++) {
+        u8 c = *text;
+        
+        setBufferedTile(x, y, (c >= 32 && c < 128) ? TEXT_TILE(c) : TEXT_TILE('?'));
+    }
+}
+
+void clearBufferedText(u8 x, u8 y, u8 length) {
+    for (; length > 0 && x < TEXT_COLUMNS; length--, x++) {
+        setBufferedTile(x, y, TEXT_BLANK);
+    }
+}
+
+void drawTimedText(const char* text, u8 x, u8 y, u16 frames) {
+    TimedText* slot = NULL;
+    u8 length = 0;
+    u8 i;
+    
+    while (text[length] && x + length < TEXT_COLUMNS) length++;
+    
+    drawBufferedText(text, x, y);
+    
+    // Même position : le délai repart et couvre le plus long des deux textes
+    for (i = 0; i < TEXT_TIMED_MESSAGES; i++) {
+        TimedText* timed = &timedTexts[i];
+        
+        if (timed->timer && timed->x == x && timed->y == y) {
+            if (timed->length > length) length = timed->length;
+            slot = timed;
+            break;
+        }
+        if (!timed->timer && !slot) slot = timed;
+    }
+    
+    // Plus d'entrée libre : le texte reste affiché
+    if (!slot) return;
+    
+    slot->x = x;
+    slot->y = y;
+    slot->length = length;
+    slot->timer = frames ? frames : 1;
+}
+
+static bool isCellDirty(u8 x, u8 y) {
+    return (dirtyCells[y][x >> 3] & (1 << (x & 7))) != 0;
+}
+
+// Suites de cellules modifiées de la ligne, un job par suite : les cellules
+// entre deux textes ne sont pas envoyées. Retourne FALSE si la ligne n'a pu
+// être envoyée entière (file pleine ou jobs de la frame épuisés) ; le reste
+// part à la frame suivante.
+static bool flushTextRow(u8 y, u8* jobs) {
+    u8 x = dirtyFirst[y];
+    
+    while (x < TEXT_COLUMNS) {
+        u8 first, n;
+        
+        if (!isCellDirty(x, y)) {
+            x++;
+            continue;
+        }
+        
+        for (first = x; x < TEXT_COLUMNS && isCellDirty(x, y); x++);
+        
+        if (*jobs >= TEXT_JOBS_PER_FLUSH ||
+            !queueDMAJob(DMA_VRAM, &textMap[y][first],
+                         VRAM_PLANE_B + ((y * TEXT_PLANE_WIDTH) + first) * 2,
+                         x - first, DMA_PRIORITY_NORMAL, &rowQueued[y])) {
+            dirtyFirst[y] = first;
+            return FALSE;
+        }
+        (*jobs)++;
+        
+        for (n = first; n < x; n++) {
+            dirtyCells[y][n >> 3] &= ~(1 << (n & 7));
+        }
+    }
+    
+    dirtyFirst[y] = TEXT_CLEAN;
+    return TRUE;
+}
+
+void flushTextBuffer(void) {
+    u8 i, jobs = 0;
+    u8 y = flushRow;
+    
+    // Une fois par frame : les messages échus sont effacés
+    for (i = 0; i < TEXT_TIMED_MESSAGES; i++) {
+        TimedText* timed = &timedTexts[i];
+        
+        if (timed->timer && --timed->timer == 0) {
+            clearBufferedText(timed->x, timed->y, timed->length);
+        }
+    }
+    
+    // Lignes modifiées, au plus TEXT_JOBS_PER_FLUSH jobs, départ tournant
+    // pour qu'un écran chargé n'affame pas les dernières lignes
+    for (i = 0; i < TEXT_ROWS; i++) {
+        if (dirtyFirst[y] != TEXT_CLEAN && !rowQueued[y] && !flushTextRow(y, &jobs)) {
+            break;           // La suite à la frame suivante, depuis cette ligne
+        }
+        
+        if (++y >= TEXT_ROWS) y = 0;
+    }
+    flushRow = y;
+}
@@ -0,0 +1,84 @@
+/* track.c - Trajectoire idéale et profil de vitesse précalculés par niveau */
+
+#include <genesis.h>
+#include "track.h"
+
+#define LINE_WINDOW      8      // Lissage de la ligne : ±8 entrées (±32 unités)
+#define LINE_GAIN        5      // Décalage = courbe moyenne * 5 / 2
+#define LINE_MAX         60     // Décalage max depuis le centre (px)
+#define CORNER_SLOWDOWN  2      // Vitesse perdue par unité de courbe
+#define CORNER_MIN_SPEED 64     // Plancher du profil (moitié de maxSpeed)
+#define BRAKE_RAMP       2      // Regain de vitesse max par entrée (freinage anticipé)
+
+// Avant buildRacingLine : une seule entrée, pleine vitesse au centre
+s8 racingLineX[RACING_LINE_SIZE];
+u8 racingLineSpeed[RACING_LINE_SIZE] = { RACING_SPEED_ONE };
+u16 racingLineLength = 1;
+u8 racingLineAverage = RACING_SPEED_ONE;
+
+void buildRacingLine(const TrackSegment* track) {
+    s8 curve[RACING_LINE_SIZE];
+    u32 segmentEnd = track->length;
+    u32 speedSum = 0;
+    u16 n, count;
+    s16 k;
+    
+    // Courbe sous chaque entrée
+    for (n = 0; n < RACING_LINE_SIZE; n++) {
+        u32 position = (u32)n << RACING_LINE_SHIFT;
+        
+        while (track->length != TRACK_END_LENGTH && position >= segmentEnd) {
+            track++;
+            segmentEnd += track->length;
+        }
+        if (track->length == TRACK_END_LENGTH) break;
+        
+        curve[n] = track->curve;
+    }
+    
+    count = n;
+    if (count == 0) {
+        curve[0] = 0;
+        count = 1;
+    }
+    
+    // Ligne : courbe lissée sur la fenêtre, l'apex vers l'intérieur
+    // (entrée progressive avant le virage, sortie progressive après)
+    for (n = 0; n < count; n++) {
+        s16 sum = 0;
+        
+        for (k = (s16)n - LINE_WINDOW; k < (s16)n + LINE_WINDOW; k++) {
+            sum += curve[(k < 0) ? 0 : (k >= count) ? count - 1 : k];
+        }
+        
+        s16 offset = (sum * LINE_GAIN) >> 5;
+        if (offset > LINE_MAX) offset = LINE_MAX;
+        if (offset < -LINE_MAX) offset = -LINE_MAX;
+        racingLineX[n] = offset;
+    }
+    
+    // Vitesse : plafond de virage, puis passe arrière pour freiner avant
+    // chaque virage plutôt qu'en y entrant
+    for (k = count - 1; k >= 0; k--) {
+        s16 speed = RACING_SPEED_ONE - CORNER_SLOWDOWN * abs(curve[k]);
+        
+        if (speed < CORNER_MIN_SPEED) speed = CORNER_MIN_SPEED;
+        if (k + 1 < count && speed > racingLineSpeed[k + 1] + BRAKE_RAMP) {
+            speed = racingLineSpeed[k + 1] + BRAKE_RAMP;
+        }
+        
+        racingLineSpeed[k] = speed;
+        speedSum += speed;
+    }
+    
+    racingLineLength = count;
+    racingLineAverage = speedSum / count;
+}
+
+u16 getRacingLineIndex(s32 worldZ) {
+    // Derrière le départ : première entrée ; après l'arrivée : dernière
+    if (worldZ < 0) return 0;
+    
+    u16 index = (u32)worldZ >> (16 + RACING_LINE_SHIFT);
+    return (index < racingLineLength) ? index : racingLineLength - 1;
+}
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""
+Générateur des objets de bord de route pré-zoomés pour Urban Thunder
+
+Une planche source contient un objet de 32x32 par type (arbre, panneau,
+poteau, puis voiture, flaque d'huile et bonus des entités de la route),
+côte à côte. Même traitement que les frames de rider
+(generate_zoom_frames.py) : réduction au plus proche voisin pour chaque
+niveau de zoom, tuiles dans l'ordre des sprites VDP. Sortie : une image
+par zoom, le type t commençant à la tuile t * (largeur * hauteur).
+
+Doit rester en accord avec inc/scenery.h (SCENERY_TYPES, ordre des types).
+
+Usage : generate_scenery_frames.py [planche.png]
+Sans planche (ou planche absente), des silhouettes de remplacement sont générées.
+"""
+
+import os
+import sys
+
+from generate_zoom_frames import (FRAME_SIZE, OUTPUT_DIR, ZOOM_TILES,
+                                  write_indexed_png, zoom_strip)
+
+SCENERY_TYPES = 6                # Arbre, panneau, poteau, voiture, flaque, bonus
+DEFAULT_SHEET = "res/scenery_sheet.png"
+
+# Index de la palette PAL1 (simple_palette.png)
+TRUNK, LEAVES, LEAVES_LIGHT, POLE, SIGN, SIGN_TEXT, STRIPE = 10, 7, 13, 2, 8, 4, 6
+TYRE, GLASS, BODY, OIL, OIL_SHINE = 1, 14, 9, 15, 3
+
+
+def placeholder_frames():
+    """Silhouettes de remplacement, pied de l'objet en bas de la frame."""
+    frames = []
+
+    # Arbre : tronc et feuillage rond
+    tree = [[0] * FRAME_SIZE for _ in range(FRAME_SIZE)]
+    for y in range(22, 32):
+        for x in range(14, 18):
+            tree[y][x] = TRUNK
+    for y in range(FRAME_SIZE):
+        for x in range(FRAME_SIZE):
+            d = (x - 16) ** 2 + (y - 12) ** 2
+            if d <= 121:
+                tree[y][x] = LEAVES_LIGHT if d <= 30 and x < 16 else LEAVES
+    frames.append(tree)
+
+    # Panneau : deux pieds et un cadre bleu à bandes blanches
+    sign = [[0] * FRAME_SIZE for _ in range(FRAME_SIZE)]
+    for y in range(18, 32):
+        for x in (8, 9, 22, 23):
+            sign[y][x] = POLE
+    for y in range(4, 18):
+        for x in range(3, 29):
+            sign[y][x] = SIGN_TEXT if y in (8, 13) and 6 <= x < 26 else SIGN
+    frames.append(sign)
+
+    # Poteau de bordure : blanc à bande rouge
+    post = [[0] * FRAME_SIZE for _ in range(FRAME_SIZE)]
+    for y in range(12, 32):
+        for x in range(14, 18):
+            post[y][x] = STRIPE if 15 <= y < 19 else SIGN_TEXT
+    frames.append(post)
+
+    # Voiture vue de l'arrière : caisse, lunette, feux et pneus
+    car = [[0] * FRAME_SIZE for _ in range(FRAME_SIZE)]
+    for y in range(26, 32):
+        for x in list(range(4, 9)) + list(range(23, 28)):
+            car[y][x] = TYRE
+    for y in range(10, 28):
+        for x in range(3, 29):
+            car[y][x] = BODY
+    for y in range(12, 18):
+        for x in range(7, 25):
+            car[y][x] = GLASS
+    for y in range(21, 24):
+        for x in list(range(4, 8)) + list(range(24, 28)):
+            car[y][x] = STRIPE
+    frames.append(car)
+
+    # Flaque d'huile : ellipse sombre à plat, reflet clair
+    oil = [[0] * FRAME_SIZE for _ in range(FRAME_SIZE)]
+    for y in range(24, 32):
+        for x in range(FRAME_SIZE):
+            d = ((x - 16) / 14) ** 2 + ((y - 28) / 4) ** 2
+            if d <= 1:
+                oil[y][x] = OIL_SHINE if d <= 0.15 and x < 16 else OIL
+    frames.append(oil)
+
+    # Bonus de santé : caisse blanche à croix rouge
+    pickup = [[0] * FRAME_SIZE for _ in range(FRAME_SIZE)]
+    for y in range(16, 32):
+        for x in range(8, 24):
+            pickup[y][x] = SIGN_TEXT
+    for y in range(18, 30):
+        for x in range(14, 18):
+            pickup[y][x] = STRIPE
+    for y in range(22, 26):
+        for x in range(10, 22):
+            pickup[y][x] = STRIPE
+    frames.append(pickup)
+
+    return frames
+
+
+def load_frames(path):
+    """Objets d'une planche indexée (PIL), SCENERY_TYPES objets côte à côte."""
+    from PIL import Image
+    img = Image.open(path)
+    if img.mode != "P":
+        raise SystemExit(f"{path} : image indexée (16 couleurs) attendue")
+    return [[[img.getpixel((t * FRAME_SIZE + x, y)) & 0x0F
+              for x in range(FRAME_SIZE)] for y in range(FRAME_SIZE)]
+            for t in range(SCENERY_TYPES)]
+
+
+def main():
+    sheet = sys.argv[1] if len(sys.argv) > 1 else DEFAULT_SHEET
+    os.makedirs(OUTPUT_DIR, exist_ok=True)
+
+    if os.path.exists(sheet):
+        frames = load_frames(sheet)
+    else:
+        print(f"  {sheet} absente : silhouettes de remplacement")
+        frames = placeholder_frames()
+
+    for zoom, tiles in enumerate(ZOOM_TILES):
+        name = os.path.join(OUTPUT_DIR, f"scenery_zoom{zoom}.png")
+        write_indexed_png(name, zoom_strip(frames, tiles))
+        print(f"  - {name} ({SCENERY_TYPES} objets de {tiles}x{tiles} tuiles)")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""
+Générateur des frames de rider pré-zoomées pour Urban Thunder
+
+Chaque planche source (une par modèle de moto) contient les frames
+d'animation 32x32 côte à côte. Pour chaque niveau de zoom, les frames sont
+réduites au plus proche voisin (les index de palette sont conservés), puis
+découpées en tuiles dans l'ordre des sprites VDP (colonne par colonne).
+Sortie : une image de 8 pixels de large par (modèle, zoom), lue par ResComp
+comme TILESET sans optimisation, de sorte que la frame f d'un zoom commence
+à la tuile f * (largeur * hauteur).
+
+Doit rester en accord avec inc/rider_frames.h (RIDER_ZOOM_*, RIDER_ANIM_FRAMES).
+
+Usage : generate_zoom_frames.py [planche0.png planche1.png ...]
+Sans planche (ou planche absente), une silhouette de remplacement est générée.
+"""
+
+import os
+import struct
+import sys
+import zlib
+
+FRAME_SIZE = 32                  # Côté d'une frame source (pixels)
+ANIM_FRAMES = 4                  # RIDER_ANIM_FRAMES
+ZOOM_TILES = [4, 3, 2, 1]        # Côté de chaque niveau de zoom (tuiles)
+OUTPUT_DIR = "res"
+DEFAULT_SHEETS = ["res/bike_sheet0.png", "res/bike_sheet1.png"]
+
+# Palette PAL1 des riders (simple_palette.png)
+PALETTE = [
+    (0, 0, 0), (68, 68, 68), (136, 136, 136), (204, 204, 204),
+    (255, 255, 255), (255, 255, 0), (255, 0, 0), (0, 255, 0),
+    (0, 0, 255), (255, 136, 0), (136, 68, 0), (255, 0, 255),
+    (0, 255, 255), (68, 255, 68), (0, 136, 255), (102, 102, 102),
+]
+
+
+def scale_frame(frame, size):
+    """Réduction au plus proche voisin d'une frame carrée (liste de lignes d'index)."""
+    source = len(frame)
+    return [[frame[(y * source) // size][(x * source) // size]
+             for x in range(size)] for y in range(size)]
+
+
+def frame_tiles(frame):
+    """Tuiles 8x8 d'une frame dans l'ordre des sprites VDP : colonne par colonne."""
+    tiles = len(frame) // 8
+    result = []
+    for tx in range(tiles):
+        for ty in range(tiles):
+            result.append([row[tx * 8:tx * 8 + 8] for row in frame[ty * 8:ty * 8 + 8]])
+    return result
+
+
+def zoom_strip(frames, tiles):
+    """Toutes les frames d'un zoom, empilées en une colonne de tuiles."""
+    rows = []
+    for frame in frames:
+        for tile in frame_tiles(scale_frame(frame, tiles * 8)):
+            rows.extend(tile)
+    return rows
+
+
+def placeholder_frames(design):
+    """Silhouette de remplacement : roues, cadre et pilote, couleurs par modèle."""
+    body = 6 if design % 2 == 0 else 8
+    frames = []
+    for f in range(ANIM_FRAMES):
+        frame = [[0] * FRAME_SIZE for _ in range(FRAME_SIZE)]
+        # Roues, rayon qui tourne avec la frame
+        for cx in (8, 23):
+            for y in range(FRAME_SIZE):
+                for x in range(FRAME_SIZE):
+                    d = (x - cx) ** 2 + (y - 25) ** 2
+                    if d <= 36:
+                        frame[y][x] = 1 if d >= 16 else 2
+            spoke = [(1, 0), (1, 1), (0, 1), (-1, 1)][f]
+            for r in range(-3, 4):
+                frame[25 + spoke[1] * r][cx + spoke[0] * r] = 3
+        # Cadre et pilote
+        for y in range(17, 22):
+            for x in range(8, 24):
+                frame[y][x] = body
+        for y in range(6, 17):
+            for x in range(13, 19):
+                frame[y][x] = body if y >= 11 else 4
+        frames.append(frame)
+    return frames
+
+
+def load_frames(path):
+    """Frames d'une planche indexée (PIL), ANIM_FRAMES frames de FRAME_SIZE de côté."""
+    from PIL import Image
+    img = Image.open(path)
+    if img.mode != "P":
+        raise SystemExit(f"{path} : image indexée (16 couleurs) attendue")
+    frames = []
+    for f in range(ANIM_FRAMES):
+        frames.append([[img.getpixel((f * FRAME_SIZE + x, y)) & 0x0F
+                        for x in range(FRAME_SIZE)] for y in range(FRAME_SIZE)])
+    return frames
+
+
+def write_indexed_png(path, rows):
+    """PNG indexé 8 bits (palette de 16 couleurs), sans dépendance externe."""
+    height = len(rows)
+    width = len(rows[0])
+
+    def chunk(tag, data):
+        return (struct.pack(">I", len(data)) + tag + data +
+                struct.pack(">I", zlib.crc32(tag + data) & 0xFFFFFFFF))
+
+    raw = b"".join(b"\x00" + bytes(row) for row in rows)
+    with open(path, "wb") as out:
+        out.write(b"\x89PNG\r\n\x1a\n")
+        out.write(chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 8, 3, 0, 0, 0)))
+        out.write(chunk(b"PLTE", b"".join(bytes(c) for c in PALETTE)))
+        out.write(chunk(b"IDAT", zlib.compress(raw, 9)))
+        out.write(chunk(b"IEND", b""))
+
+
+def main():
+    sheets = sys.argv[1:] or DEFAULT_SHEETS
+    os.makedirs(OUTPUT_DIR, exist_ok=True)
+
+    for design, sheet in enumerate(sheets):
+        if os.path.exists(sheet):
+            frames = load_frames(sheet)
+        else:
+            print(f"  {sheet} absente : silhouette de remplacement")
+            frames = placeholder_frames(design)
+
+        for zoom, tiles in enumerate(ZOOM_TILES):
+            name = os.path.join(OUTPUT_DIR, f"bike{design}_zoom{zoom}.png")
+            write_indexed_png(name, zoom_strip(frames, tiles))
+            print(f"  - {name} ({ANIM_FRAMES} frames de {tiles}x{tiles} tuiles)")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,937 @@
+#!/usr/bin/env python3
+"""
+Simulateur 68000 au niveau source pour les routines assembleur du projet.
+
+Il lit directement les fichiers .s de src/ (syntaxe GAS m68k, registres sans
+préfixe %, préprocesseur C comme le fait makefile.gen) et exécute une fonction
+avec l'ABI m68k-elf GCC : arguments empilés en long, retour dans d0,
+d2-d7/a2-a6 préservés par l'appelé.
+
+Un modèle minimal du VDP (ports 0xC00000 / 0xC00004, auto-incrément,
+VRAM/CRAM/VSRAM, DMA 68k -> VDP) capture ce que la routine écrit, pour
+comparer le résultat à un modèle de référence C (voir road_harness.py).
+
+Le nombre de cycles retourné est une estimation (accès bus + coûts internes
+des mul/div/décalages/branchements), utile pour comparer deux versions d'une
+même routine, pas pour un profilage exact.
+"""
+
+import re
+import subprocess
+
+ADDR_MASK = 0xFFFFFF
+SIZE_BITS = {'b': 8, 'w': 16, 'l': 32}
+CODE_BASE = 0x200000
+DATA_BASE = 0x300000
+BSS_BASE = 0xFF8000
+RETURN_SENTINEL = 0x1FFFFE
+
+
+class SimError(Exception):
+    pass
+
+
+def mask_of(size):
+    return (1 << SIZE_BITS[size]) - 1
+
+
+def msb_of(size):
+    return 1 << (SIZE_BITS[size] - 1)
+
+
+def to_signed(value, size):
+    value &= mask_of(size)
+    return value - (1 << SIZE_BITS[size]) if value & msb_of(size) else value
+
+
+# === PRÉPROCESSEUR ET ANALYSE DU SOURCE ===
+
+def preprocess(path, include_dirs=(), defines=()):
+    """Passe le fichier .s dans cpp (équivalent de -x assembler-with-cpp)"""
+    cmd = ['cpp', '-P', '-undef', '-D__ASSEMBLER__']
+    cmd += ['-I' + d for d in include_dirs]
+    cmd += ['-D' + d for d in defines]
+    cmd += ['-x', 'assembler-with-cpp', path]
+    return subprocess.run(cmd, check=True, capture_output=True, text=True).stdout
+
+
+def strip_comments(text):
+    text = re.sub(r'/\*.*?\*/', lambda m: '\n' * m.group(0).count('\n'), text, flags=re.S)
+    lines = []
+    for line in text.split('\n'):
+        # Commentaires de fin de ligne GAS (# en début de ligne, ; ou |)
+        line = re.sub(r'^\s*#.*$', '', line)
+        line = line.split(';')[0]
+        lines.append(line)
+    return lines
+
+
+def split_operands(text):
+    parts, depth, cur = [], 0, ''
+    for ch in text:
+        if ch == '(':
+            depth += 1
+        elif ch == ')':
+            depth -= 1
+        if ch == ',' and depth == 0:
+            parts.append(cur.strip())
+            cur = ''
+        else:
+            cur += ch
+    if cur.strip():
+        parts.append(cur.strip())
+    return parts
+
+
+class Program:
+    """Fichier assembleur analysé : instructions, labels, équates, données"""
+
+    def __init__(self, paths, include_dirs=(), defines=()):
+        if isinstance(paths, str):
+            paths = [paths]
+        self.instrs = []
+        self.labels = {}
+        self.equates = {}
+        self.data = {}          # adresse -> octet (sections .data / .rodata)
+        self.externs = {}
+        self._data_ptr = DATA_BASE
+        self._bss_ptr = BSS_BASE
+        for path in paths:
+            self._parse(strip_comments(preprocess(path, include_dirs, defines)), path)
+
+    def _parse(self, lines, path):
+        section = 'text'
+        rept_stack = []
+        pending = []
+
+        def emit(line, lineno):
+            nonlocal section
+            line = line.strip()
+            if not line:
+                return
+            # Labels (éventuellement suivis d'une instruction)
+            m = re.match(r'^([A-Za-z_.$][\w.$]*|\d+):\s*(.*)$', line)
+            if m:
+                self._define_label(m.group(1), section)
+                emit(m.group(2), lineno)
+                return
+            m = re.match(r'^([A-Za-z_][\w.]*)\s*=\s*(.+)$', line) or \
+                re.match(r'^\.(?:set|equ)\s+([A-Za-z_][\w.]*)\s*,\s*(.+)$', line)
+            if m:
+                self.equates[m.group(1)] = m.group(2).strip()
+                return
+            parts = line.split(None, 1)
+            op = parts[0].lower()
+            args = parts[1] if len(parts) > 1 else ''
+            if op.startswith('.'):
+                section = self._directive(op, args, section)
+                return
+            if section != 'text':
+                raise SimError('%s:%d: instruction hors section .text' % (path, lineno))
+            mnem, _, size = op.partition('.')
+            self.instrs.append((mnem, size, split_operands(args), '%s:%d' % (path, lineno)))
+
+        for lineno, line in enumerate(lines, 1):
+            stripped = line.strip()
+            if stripped.lower().startswith('.rept'):
+                rept_stack.append((stripped.split(None, 1)[1], []))
+                continue
+            if stripped.lower().startswith('.endr'):
+                count, body = rept_stack.pop()
+                expanded = body * self.eval(count)
+                if rept_stack:
+                    rept_stack[-1][1].extend(expanded)
+                else:
+                    for l, n in expanded:
+                        emit(l, n)
+                continue
+            if rept_stack:
+                rept_stack[-1][1].append((line, lineno))
+            else:
+                emit(line, lineno)
+
+    def _define_label(self, name, section):
+        if section == 'text':
+            self.labels[name] = CODE_BASE + 4 * len(self.instrs)
+        elif section == 'bss':
+            self.labels[name] = self._bss_ptr
+        else:
+            self.labels[name] = self._data_ptr
+
+    def _directive(self, op, args, section):
+        if op in ('.text',):
+            return 'text'
+        if op in ('.data',):
+            return 'data'
+        if op in ('.bss',):
+            return 'bss'
+        if op == '.section':
+            name = args.split(',')[0].strip()
+            if name.startswith('.bss'):
+                return 'bss'
+            if name.startswith('.text'):
+                return 'text'
+            return 'data'
+        if op in ('.global', '.globl', '.type', '.size', '.file', '.ident', '.extern'):
+            return section
+        if op in ('.align', '.balign', '.even'):
+            align = 2 if op == '.even' or not args else self.eval(args.split(',')[0])
+            if op == '.align' and align < 8 and args:
+                align = 1 << align if align > 2 else align
+            attr = '_bss_ptr' if section == 'bss' else '_data_ptr'
+            ptr = getattr(self, attr)
+            setattr(self, attr, (ptr + align - 1) // align * align)
+            return section
+        if op in ('.byte', '.word', '.short', '.long'):
+            size = {'.byte': 1, '.word': 2, '.short': 2, '.long': 4}[op]
+            for item in split_operands(args):
+                value = self.eval(item) & ((1 << (8 * size)) - 1)
+                for i in range(size):
+                    self.data[self._data_ptr + i] = (value >> (8 * (size - 1 - i))) & 0xFF
+                self._data_ptr += size
+            return section
+        if op in ('.space', '.skip', '.ds.b', '.ds.w', '.ds.l'):
+            n = self.eval(args.split(',')[0]) * {'.ds.w': 2, '.ds.l': 4}.get(op, 1)
+            if section == 'bss':
+                self._bss_ptr += n
+            else:
+                for i in range(n):
+                    self.data[self._data_ptr + i] = 0
+                self._data_ptr += n
+            return section
+        if op in ('.lcomm', '.comm'):
+            name, n = [a.strip() for a in args.split(',')[:2]]
+            self._bss_ptr = (self._bss_ptr + 1) & ~1
+            self.labels[name] = self._bss_ptr
+            self._bss_ptr += self.eval(n)
+            return section
+        raise SimError('directive non supportée: %s' % op)
+
+    def eval(self, expr, depth=0):
+        if depth > 32:
+            raise SimError('équate récursive: %s' % expr)
+        tokens = re.findall(r'0[xX][0-9a-fA-F]+|0[bB][01]+|\d+|[A-Za-z_.$][\w.$]*|<<|>>|[-+*/%&|^~()!]', expr)
+        out = []
+        for tok in tokens:
+            if re.match(r'^0[bB]', tok):
+                out.append(str(int(tok[2:], 2)))
+            elif re.match(r'^[A-Za-z_.$]', tok):
+                out.append('(%d)' % self.symbol(tok, depth))
+            elif tok == '/':
+                out.append('//')
+            elif tok == '!':
+                out.append(' not ')
+            else:
+                out.append(tok)
+        return int(eval(''.join(out), {'__builtins__': {}}))
+
+    def symbol(self, name, depth=0):
+        if name in self.labels:
+            return self.labels[name]
+        if name in self.externs:
+            return self.externs[name]
+        if name in self.equates:
+            return self.eval(self.equates[name], depth + 1)
+        raise SimError('symbole inconnu: %s' % name)
+
+
+# === MODÈLE VDP ===
+
+class Vdp:
+    def __init__(self):
+        self.vram = bytearray(0x10000)
+        self.cram = [0] * 64
+        self.vsram = [0] * 40
+        self.regs = [0] * 24
+        self.regs[15] = 2
+        self.code = 0
+        self.addr = 0
+        self.pending = False
+        self.words_written = 0
+        self.status = 0x3400
+
+    def write_ctrl(self, w, mem):
+        if self.pending:
+            self.addr = (self.addr & 0x3FFF) | ((w & 3) << 14)
+            self.code = (self.code & 3) | ((w >> 2) & 0x3C)
+            self.pending = False
+            if self.code & 0x20 and self.regs[1] & 0x10:
+                self._dma(mem)
+            return
+        if (w & 0xC000) == 0x8000:
+            self.regs[(w >> 8) & 0x1F] = w & 0xFF
+            return
+        self.code = (self.code & 0x3C) | (w >> 14)
+        self.addr = (self.addr & 0xC000) | (w & 0x3FFF)
+        self.pending = True
+
+    def _dma(self, mem):
+        length = self.regs[19] | (self.regs[20] << 8) or 0x10000
+        src = ((self.regs[21] | (self.regs[22] << 8) | ((self.regs[23] & 0x7F) << 16)) << 1)
+        if self.regs[23] & 0x80:
+            raise SimError('DMA fill/copy non supporté par le simulateur')
+        for i in range(length):
+            w = mem.peek16((src + 2 * i) & ADDR_MASK)
+            self.write_data(w)
+        self.code &= 0x1F
+
+    def write_data(self, w):
+        target = self.code & 0xF
+        self.words_written += 1
+        if target == 1:
+            a = self.addr & 0xFFFE
+            self.vram[a] = w >> 8
+            self.vram[a + 1] = w & 0xFF
+        elif target == 3:
+            self.cram[(self.addr >> 1) & 0x3F] = w & 0x0EEE
+        elif target == 5:
+            self.vsram[((self.addr >> 1) & 0x3F) % 40] = w & 0x7FF
+        self.addr = (self.addr + self.regs[15]) & 0xFFFF
+
+    def read_data(self):
+        target = self.code & 0xF
+        if target == 0:
+            a = self.addr & 0xFFFE
+            w = (self.vram[a] << 8) | self.vram[a + 1]
+        elif target == 8:
+            w = self.cram[(self.addr >> 1) & 0x3F]
+        elif target == 4:
+            w = self.vsram[((self.addr >> 1) & 0x3F) % 40]
+        else:
+            raise SimError('lecture VDP avec code d\'écriture %d' % target)
+        self.addr = (self.addr + self.regs[15]) & 0xFFFF
+        return w
+
+    def vram_word(self, addr):
+        return (self.vram[addr] << 8) | self.vram[addr + 1]
+
+
+# === MACHINE ===
+
+class Machine:
+    def __init__(self, program):
+        self.prog = program
+        self.mem = bytearray(ADDR_MASK + 1)
+        for addr, byte in program.data.items():
+            self.mem[addr] = byte
+        self.vdp = Vdp()
+        self.d = [0] * 8
+        self.a = [0] * 8
+        self.flags = {'X': 0, 'N': 0, 'Z': 0, 'V': 0, 'C': 0}
+        self.cycles = 0
+        self.executed = 0
+        self.addr_to_index = {CODE_BASE + 4 * i: i for i in range(len(program.instrs))}
+
+    # --- Mémoire ---
+
+    def peek16(self, addr):
+        return (self.mem[addr] << 8) | self.mem[addr + 1]
+
+    def read(self, addr, size):
+        addr &= ADDR_MASK
+        if size != 'b' and addr & 1:
+            raise SimError('ADDRESS ERROR en lecture à 0x%06X' % addr)
+        self.cycles += 8 if size == 'l' else 4
+        if 0xC00000 <= addr < 0xC00020:
+            return self._read_io(addr, size)
+        if size == 'b':
+            return self.mem[addr]
+        if size == 'w':
+            return self.peek16(addr)
+        return (self.peek16(addr) << 16) | self.peek16(addr + 2)
+
+    def write(self, addr, size, value):
+        addr &= ADDR_MASK
+        if size != 'b' and addr & 1:
+            raise SimError('ADDRESS ERROR en écriture à 0x%06X' % addr)
+        self.cycles += 8 if size == 'l' else 4
+        value &= mask_of(size)
+        if 0xC00000 <= addr < 0xC00020:
+            self._write_io(addr, size, value)
+            return
+        if addr < 0x400000:
+            if not (DATA_BASE <= addr < BSS_BASE):
+                raise SimError('écriture en ROM à 0x%06X' % addr)
+        n = SIZE_BITS[size] // 8
+        for i in range(n):
+            self.mem[addr + i] = (value >> (8 * (n - 1 - i))) & 0xFF
+
+    def _write_io(self, addr, size, value):
+        words = [value >> 16, value & 0xFFFF] if size == 'l' else [value]
+        for w in words:
+            if addr & 0x1C == 0:
+                self.vdp.write_data(w)
+            elif addr & 0x1C == 4:
+                self.vdp.write_ctrl(w, self)
+            elif size == 'b':
+                pass
+            else:
+                raise SimError('écriture port VDP non gérée 0x%06X' % addr)
+
+    def _read_io(self, addr, size):
+        if addr & 0x1C == 0:
+            if size == 'l':
+                return (self.vdp.read_data() << 16) | self.vdp.read_data()
+            return self.vdp.read_data()
+        if addr & 0x1C == 4:
+            self.vdp.pending = False
+            return self.vdp.status
+        return 0
+
+    def poke(self, addr, data):
+        self.mem[addr:addr + len(data)] = data
+
+    def poke16(self, addr, value):
+        self.mem[addr] = (value >> 8) & 0xFF
+        self.mem[addr + 1] = value & 0xFF
+
+    def poke32(self, addr, value):
+        self.poke16(addr, (value >> 16) & 0xFFFF)
+        self.poke16(addr + 2, value & 0xFFFF)
+
+    def peek32(self, addr):
+        return (self.peek16(addr) << 16) | self.peek16(addr + 2)
+
+    # --- Registres ---
+
+    def push(self, value):
+        self.a[7] = (self.a[7] - 4) & 0xFFFFFFFF
+        self.write(self.a[7], 'l', value)
+
+    def pop(self):
+        value = self.read(self.a[7], 'l')
+        self.a[7] = (self.a[7] + 4) & 0xFFFFFFFF
+        return value
+
+    def set_d(self, n, size, value):
+        m = mask_of(size)
+        self.d[n] = (self.d[n] & ~m & 0xFFFFFFFF) | (value & m)
+
+    # --- Adressage ---
+
+    REG_RE = re.compile(r'^(%?)(d[0-7]|a[0-7]|sp|fp)$', re.I)
+
+    def reg(self, text):
+        m = self.REG_RE.match(text.strip())
+        if not m:
+            return None
+        r = m.group(2).lower()
+        if r == 'sp':
+            return ('a', 7)
+        if r == 'fp':
+            return ('a', 6)
+        return (r[0], int(r[1]))
+
+    def decode(self, text):
+        """Retourne une description d'opérande (mode, ...)"""
+        t = text.strip()
+        if t.startswith('#'):
+            return ('imm', self.prog.eval(t[1:]))
+        r = self.reg(t)
+        if r:
+            return ('dreg', r[1]) if r[0] == 'd' else ('areg', r[1])
+        m = re.match(r'^-\((\w+)\)$', t)
+        if m:
+            return ('predec', self.reg(m.group(1))[1])
+        m = re.match(r'^\((\w+)\)\+$', t)
+        if m:
+            return ('postinc', self.reg(m.group(1))[1])
+        m = re.match(r'^(.*)\(([^()]*)\)$', t)
+        if m and (m.group(1) == '' or not m.group(1).rstrip().endswith(('+', '-', '*', '/', '|', '&', '<', '>'))):
+            outer, inner = m.group(1).strip(), [p.strip() for p in m.group(2).split(',')]
+            regs = [p for p in inner if self.reg(p.split('.')[0]) or p.lower() == 'pc']
+            exprs = [p for p in inner if p not in regs]
+            disp_text = ' + '.join([x for x in [outer] + exprs if x]) or '0'
+            if regs and regs[0].lower() == 'pc':
+                return ('abs', self.prog.eval(disp_text))
+            if regs:
+                base = self.reg(regs[0])
+                if base[0] != 'a':
+                    raise SimError('base d\'adressage invalide: %s' % t)
+                disp = self.prog.eval(disp_text)
+                if len(regs) == 1:
+                    return ('disp', base[1], disp) if disp_text != '0' else ('ind', base[1])
+                xname, _, xsize = regs[1].partition('.')
+                return ('index', base[1], disp, self.reg(xname), (xsize or 'w').lower())
+        t = re.sub(r'\.[wl]$', '', t, flags=re.I)
+        return ('abs', self.prog.eval(t))
+
+    def ea(self, op, size):
+        mode = op[0]
+        if mode == 'ind':
+            return self.a[op[1]]
+        if mode == 'disp':
+            self.cycles += 4
+            return (self.a[op[1]] + op[2]) & 0xFFFFFFFF
+        if mode == 'index':
+            self.cycles += 6
+            kind, n = op[3]
+            x = self.d[n] if kind == 'd' else self.a[n]
+            if op[4] == 'w':
+                x = to_signed(x, 'w')
+            return (self.a[op[1]] + op[2] + x) & 0xFFFFFFFF
+        if mode == 'abs':
+            self.cycles += 8
+            return op[1] & 0xFFFFFFFF
+        if mode in ('predec', 'postinc'):
+            step = SIZE_BITS[size] // 8
+            if op[1] == 7 and step == 1:
+                step = 2
+            if mode == 'predec':
+                self.cycles += 2
+                self.a[op[1]] = (self.a[op[1]] - step) & 0xFFFFFFFF
+                return self.a[op[1]]
+            addr = self.a[op[1]]
+            self.a[op[1]] = (addr + step) & 0xFFFFFFFF
+            return addr
+        raise SimError('mode non adressable: %s' % (op,))
+
+    def load(self, op, size):
+        mode = op[0]
+        if mode == 'imm':
+            self.cycles += 8 if size == 'l' else 4
+            return op[1] & mask_of(size)
+        if mode == 'dreg':
+            return self.d[op[1]] & mask_of(size)
+        if mode == 'areg':
+            return self.a[op[1]] & mask_of(size)
+        return self.read(self.ea(op, size), size)
+
+    def store(self, op, size, value, addr=None):
+        mode = op[0]
+        if mode == 'dreg':
+            self.set_d(op[1], size, value)
+        elif mode == 'areg':
+            if size == 'w':
+                value = to_signed(value, 'w')
+            self.a[op[1]] = value & 0xFFFFFFFF
+        else:
+            self.write(self.ea(op, size) if addr is None else addr, size, value)
+
+    # --- Codes conditions ---
+
+    def set_nz(self, value, size):
+        value &= mask_of(size)
+        self.flags['N'] = 1 if value & msb_of(size) else 0
+        self.flags['Z'] = 1 if value == 0 else 0
+
+    def logic_flags(self, value, size):
+        self.set_nz(value, size)
+        self.flags['V'] = 0
+        self.flags['C'] = 0
+
+    def add_flags(self, src, dst, size, extend=True):
+        m = mask_of(size)
+        r = (dst + src) & m
+        self.set_nz(r, size)
+        self.flags['C'] = 1 if dst + src > m else 0
+        self.flags['V'] = 1 if (~(src ^ dst) & (src ^ r)) & msb_of(size) else 0
+        if extend:
+            self.flags['X'] = self.flags['C']
+        return r
+
+    def sub_flags(self, src, dst, size, extend=True):
+        m = mask_of(size)
+        r = (dst - src) & m
+        self.set_nz(r, size)
+        self.flags['C'] = 1 if src > dst else 0
+        self.flags['V'] = 1 if ((dst ^ src) & (dst ^ r)) & msb_of(size) else 0
+        if extend:
+            self.flags['X'] = self.flags['C']
+        return r
+
+    def cond(self, cc):
+        f = self.flags
+        table = {
+            't': True, 'ra': True, 'f': False,
+            'hi': not f['C'] and not f['Z'], 'ls': f['C'] or f['Z'],
+            'cc': not f['C'], 'hs': not f['C'], 'cs': f['C'], 'lo': f['C'],
+            'ne': not f['Z'], 'eq': f['Z'], 'vc': not f['V'], 'vs': f['V'],
+            'pl': not f['N'], 'mi': f['N'],
+            'ge': f['N'] == f['V'], 'lt': f['N'] != f['V'],
+            'gt': not f['Z'] and f['N'] == f['V'], 'le': f['Z'] or f['N'] != f['V'],
+        }
+        if cc not in table:
+            raise SimError('condition inconnue: %s' % cc)
+        return table[cc]
+
+    def reglist(self, text):
+        regs = []
+        for part in text.split('/'):
+            lo, _, hi = part.partition('-')
+            r0 = self.reg(lo)
+            r1 = self.reg(hi) if hi else r0
+            i0 = r0[1] + (8 if r0[0] == 'a' else 0)
+            i1 = r1[1] + (8 if r1[0] == 'a' else 0)
+            regs.extend(range(i0, i1 + 1))
+        return sorted(regs)
+
+    def get_r(self, i):
+        return self.d[i] if i < 8 else self.a[i - 8]
+
+    def put_r(self, i, value):
+        if i < 8:
+            self.d[i] = value & 0xFFFFFFFF
+        else:
+            self.a[i - 8] = value & 0xFFFFFFFF
+
+    # --- Exécution ---
+
+    def call(self, label, args=(), max_steps=50000000):
+        """Appelle label(args...) selon l'ABI GCC et retourne d0"""
+        if self.a[7] == 0:
+            self.a[7] = 0xFFFF00
+        saved = self.d[2:8] + self.a[2:7]
+        canary = [0x5A5A0000 + i for i in range(11)]
+        for i, v in enumerate(canary):
+            self.put_r(2 + i if i < 6 else 8 + 2 + (i - 6), v)
+        sp0 = self.a[7]
+        for value in reversed(list(args)):
+            self.push(value & 0xFFFFFFFF)
+        self.push(RETURN_SENTINEL)
+        self.cycles = 0
+        self.executed = 0
+        pc = self.addr_to_index[self.prog.symbol(label)]
+        steps = 0
+        while pc is not None:
+            steps += 1
+            if steps > max_steps:
+                raise SimError('boucle infinie probable dans %s' % label)
+            pc = self.step(pc)
+        self.a[7] = (self.a[7] + 4 * len(args)) & 0xFFFFFFFF
+        if self.a[7] != sp0:
+            raise SimError('%s: pile déséquilibrée' % label)
+        now = self.d[2:8] + self.a[2:7]
+        if now != canary:
+            raise SimError('%s: registre préservé modifié (d2-d7/a2-a6)' % label)
+        self.d[2:8] = saved[:6]
+        self.a[2:7] = saved[6:]
+        return self.d[0]
+
+    def step(self, pc):
+        mnem, size, ops, where = self.prog.instrs[pc]
+        self.executed += 1
+        self.cycles += 4
+        try:
+            return self.execute(pc, mnem, size or None, ops)
+        except SimError as e:
+            raise SimError('%s: %s' % (where, e))
+
+    def jump_target(self, text):
+        addr = self.prog.symbol(text.strip())
+        if addr == RETURN_SENTINEL:
+            return None
+        if addr not in self.addr_to_index:
+            raise SimError('saut hors du code: %s' % text)
+        return self.addr_to_index[addr]
+
+    def execute(self, pc, mnem, size, ops):
+        nxt = pc + 1
+        sz = size or 'w'
+
+        # Branchements
+        if mnem in ('bra', 'jra', 'jmp'):
+            self.cycles += 6
+            if mnem == 'jmp':
+                return self.addr_to_index.get(self.ea(self.decode(ops[0]), 'l'))
+            return self.jump_target(ops[0])
+        if mnem in ('bsr', 'jsr', 'jbsr'):
+            self.cycles += 10
+            if mnem == 'jsr' and not re.match(r'^[A-Za-z_.$][\w.$]*$', ops[0].strip()):
+                target = self.addr_to_index.get(self.ea(self.decode(ops[0]), 'l'))
+            else:
+                target = self.jump_target(ops[0])
+            self.push(CODE_BASE + 4 * nxt)
+            return target
+        if mnem == 'rts':
+            self.cycles += 12
+            addr = self.pop()
+            if addr == RETURN_SENTINEL:
+                return None
+            return self.addr_to_index[addr]
+        if mnem.startswith('db'):
+            cc = mnem[2:]
+            cc = 'f' if cc in ('ra', 'f') else cc
+            if self.cond(cc):
+                self.cycles += 8
+                return nxt
+            n = self.decode(ops[0])[1]
+            cnt = (self.d[n] - 1) & 0xFFFF
+            self.set_d(n, 'w', cnt)
+            if cnt == 0xFFFF:
+                self.cycles += 10
+                return nxt
+            self.cycles += 6
+            return self.jump_target(ops[1])
+        if re.match(r'^j?b(hi|ls|cc|hs|cs|lo|ne|eq|vc|vs|pl|mi|ge|lt|gt|le)$', mnem):
+            cc = mnem.lstrip('j')[1:]
+            if self.cond(cc):
+                self.cycles += 6
+                return self.jump_target(ops[0])
+            self.cycles += 4
+            return nxt
+        if mnem == 'nop':
+            return nxt
+
+        # Transferts
+        if mnem == 'moveq':
+            v = self.prog.eval(ops[0][1:]) & 0xFF
+            v = v | 0xFFFFFF00 if v & 0x80 else v
+            n = self.decode(ops[1])[1]
+            self.d[n] = v
+            self.logic_flags(v, 'l')
+            return nxt
+        if mnem in ('move', 'movea'):
+            src, dst = self.decode(ops[0]), self.decode(ops[1])
+            v = self.load(src, sz)
+            if dst[0] == 'areg':
+                self.store(dst, sz, v)
+            else:
+                self.store(dst, sz, v)
+                self.logic_flags(v, sz)
+            return nxt
+        if mnem == 'movem':
+            return self.movem(sz if size else 'l', ops, nxt)
+        if mnem == 'lea':
+            addr = self.ea(self.decode(ops[0]), 'l')
+            self.a[self.decode(ops[1])[1]] = addr & 0xFFFFFFFF
+            return nxt
+        if mnem == 'pea':
+            self.push(self.ea(self.decode(ops[0]), 'l'))
+            return nxt
+        if mnem == 'clr':
+            self.store(self.decode(ops[0]), sz, 0)
+            self.logic_flags(0, sz)
+            return nxt
+        if mnem == 'swap':
+            n = self.decode(ops[0])[1]
+            v = ((self.d[n] << 16) | (self.d[n] >> 16)) & 0xFFFFFFFF
+            self.d[n] = v
+            self.logic_flags(v, 'l')
+            return nxt
+        if mnem == 'exg':
+            r0, r1 = self.reg(ops[0]), self.reg(ops[1])
+            i0 = r0[1] + (8 if r0[0] == 'a' else 0)
+            i1 = r1[1] + (8 if r1[0] == 'a' else 0)
+            v0, v1 = self.get_r(i0), self.get_r(i1)
+            self.put_r(i0, v1)
+            self.put_r(i1, v0)
+            return nxt
+        if mnem == 'ext':
+            n = self.decode(ops[0])[1]
+            if sz == 'w':
+                self.set_d(n, 'w', to_signed(self.d[n], 'b'))
+            else:
+                self.d[n] = to_signed(self.d[n], 'w') & 0xFFFFFFFF
+            self.logic_flags(self.d[n], sz)
+            return nxt
+        if mnem == 'tst':
+            self.logic_flags(self.load(self.decode(ops[0]), sz), sz)
+            return nxt
+        if mnem == 'link':
+            n = self.decode(ops[0])[1]
+            self.push(self.a[n])
+            self.a[n] = self.a[7]
+            self.a[7] = (self.a[7] + self.prog.eval(ops[1][1:])) & 0xFFFFFFFF
+            return nxt
+        if mnem == 'unlk':
+            n = self.decode(ops[0])[1]
+            self.a[7] = self.a[n]
+            self.a[n] = self.pop()
+            return nxt
+
+        # Arithmétique
+        if mnem in ('add', 'adda', 'addi', 'addq', 'sub', 'suba', 'subi', 'subq', 'cmp', 'cmpa', 'cmpi'):
+            return self.arith(mnem, sz, ops, nxt)
+        if mnem in ('neg', 'not'):
+            dst = self.decode(ops[0])
+            addr = None if dst[0] == 'dreg' else self.ea(dst, sz)
+            v = self.d[dst[1]] & mask_of(sz) if addr is None else self.read(addr, sz)
+            if mnem == 'neg':
+                r = self.sub_flags(v, 0, sz)
+            else:
+                r = ~v & mask_of(sz)
+                self.logic_flags(r, sz)
+            self.store(dst, sz, r, addr)
+            return nxt
+        if mnem in ('and', 'andi', 'or', 'ori', 'eor', 'eori'):
+            src, dst = self.decode(ops[0]), self.decode(ops[1])
+            a = self.load(src, sz)
+            addr = None if dst[0] in ('dreg', 'areg') else self.ea(dst, sz)
+            b = self.load(dst, sz) if addr is None else self.read(addr, sz)
+            r = {'a': a & b, 'o': a | b, 'e': a ^ b}[mnem[0]]
+            self.store(dst, sz, r, addr)
+            self.logic_flags(r, sz)
+            return nxt
+        if mnem in ('mulu', 'muls'):
+            a = self.load(self.decode(ops[0]), 'w')
+            n = self.decode(ops[1])[1]
+            b = self.d[n] & 0xFFFF
+            if mnem == 'muls':
+                a, b = to_signed(a, 'w'), to_signed(b, 'w')
+            r = (a * b) & 0xFFFFFFFF
+            self.cycles += 34 + 2 * bin(a & 0xFFFF).count('1')
+            self.d[n] = r
+            self.logic_flags(r, 'l')
+            return nxt
+        if mnem in ('divu', 'divs'):
+            a = self.load(self.decode(ops[0]), 'w')
+            n = self.decode(ops[1])[1]
+            b = self.d[n]
+            self.cycles += 136 if mnem == 'divu' else 154
+            if a == 0:
+                raise SimError('division par zéro')
+            if mnem == 'divs':
+                a, b = to_signed(a, 'w'), to_signed(b, 'l')
+                q = abs(b) // abs(a) * (1 if (a < 0) == (b < 0) else -1)
+                rem = b - q * a
+                if not -0x8000 <= q <= 0x7FFF:
+                    self.flags['V'] = 1
+                    return nxt
+            else:
+                q, rem = b // a, b % a
+                if q > 0xFFFF:
+                    self.flags['V'] = 1
+                    return nxt
+            self.d[n] = ((rem & 0xFFFF) << 16) | (q & 0xFFFF)
+            self.logic_flags(q, 'w')
+            return nxt
+
+        # Décalages
+        if mnem in ('asl', 'asr', 'lsl', 'lsr', 'rol', 'ror'):
+            return self.shift(mnem, sz, ops, nxt)
+
+        # Bits
+        if mnem in ('btst', 'bset', 'bclr', 'bchg'):
+            bit_op, dst = self.decode(ops[0]), self.decode(ops[1])
+            bit = self.load(bit_op, 'b') if bit_op[0] != 'dreg' else self.d[bit_op[1]]
+            if dst[0] == 'dreg':
+                bit &= 31
+                v = self.d[dst[1]]
+                self.flags['Z'] = 0 if v & (1 << bit) else 1
+                if mnem != 'btst':
+                    v = {'bset': v | (1 << bit), 'bclr': v & ~(1 << bit), 'bchg': v ^ (1 << bit)}[mnem]
+                    self.d[dst[1]] = v & 0xFFFFFFFF
+            else:
+                bit &= 7
+                addr = self.ea(dst, 'b')
+                v = self.read(addr, 'b')
+                self.flags['Z'] = 0 if v & (1 << bit) else 1
+                if mnem != 'btst':
+                    v = {'bset': v | (1 << bit), 'bclr': v & ~(1 << bit), 'bchg': v ^ (1 << bit)}[mnem]
+                    self.write(addr, 'b', v)
+            return nxt
+        m = re.match(r'^s(hi|ls|cc|hs|cs|lo|ne|eq|vc|vs|pl|mi|ge|lt|gt|le|t|f)$', mnem)
+        if m:
+            self.store(self.decode(ops[0]), 'b', 0xFF if self.cond(m.group(1)) else 0)
+            return nxt
+
+        raise SimError('instruction non supportée: %s' % mnem)
+
+    def movem(self, sz, ops, nxt):
+        if self.reg(ops[0].split('/')[0].split('-')[0]):
+            regs, dst = self.reglist(ops[0]), self.decode(ops[1])
+            step = SIZE_BITS[sz] // 8
+            if dst[0] == 'predec':
+                addr = self.a[dst[1]]
+                for i in reversed(regs):
+                    addr -= step
+                    self.write(addr, sz, self.get_r(i))
+                self.a[dst[1]] = addr & 0xFFFFFFFF
+            else:
+                addr = self.ea(dst, sz)
+                for i in regs:
+                    self.write(addr, sz, self.get_r(i))
+                    addr += step
+        else:
+            src, regs = self.decode(ops[0]), self.reglist(ops[1])
+            step = SIZE_BITS[sz] // 8
+            addr = self.a[src[1]] if src[0] == 'postinc' else self.ea(src, sz)
+            for i in regs:
+                v = self.read(addr, sz)
+                self.put_r(i, to_signed(v, 'w') if sz == 'w' else v)
+                addr += step
+            if src[0] == 'postinc':
+                self.a[src[1]] = addr & 0xFFFFFFFF
+        self.cycles += 8
+        return nxt
+
+    def arith(self, mnem, sz, ops, nxt):
+        src, dst = self.decode(ops[0]), self.decode(ops[1])
+        kind = mnem.rstrip('aiq')
+        if mnem in ('addq', 'subq'):
+            a = src[1]
+        elif mnem in ('adda', 'suba', 'cmpa') or dst[0] == 'areg':
+            a = self.load(src, sz)
+            if sz == 'w':
+                a = to_signed(a, 'w') & 0xFFFFFFFF
+            if kind == 'cmp':
+                self.sub_flags(a, self.a[dst[1]], 'l', extend=False)
+                return nxt
+            if dst[0] != 'areg':
+                raise SimError('%s vers un registre non adresse' % mnem)
+            self.a[dst[1]] = (self.a[dst[1]] + (a if kind == 'add' else -a)) & 0xFFFFFFFF
+            return nxt
+        else:
+            a = self.load(src, sz)
+        if dst[0] == 'areg':
+            self.a[dst[1]] = (self.a[dst[1]] + (a if kind == 'add' else -a)) & 0xFFFFFFFF
+            return nxt
+        addr = None if dst[0] == 'dreg' else self.ea(dst, sz)
+        b = self.d[dst[1]] & mask_of(sz) if addr is None else self.read(addr, sz)
+        a &= mask_of(sz)
+        if kind == 'add':
+            r = self.add_flags(a, b, sz)
+        elif kind == 'sub':
+            r = self.sub_flags(a, b, sz)
+        else:
+            self.sub_flags(a, b, sz, extend=False)
+            return nxt
+        self.store(dst, sz, r, addr)
+        return nxt
+
+    def shift(self, mnem, sz, ops, nxt):
+        if len(ops) == 1:
+            dst, count = self.decode(ops[0]), 1
+            addr = self.ea(dst, 'w')
+            v = self.read(addr, 'w')
+            sz = 'w'
+        else:
+            cnt_op, dst = self.decode(ops[0]), self.decode(ops[1])
+            count = cnt_op[1] if cnt_op[0] == 'imm' else self.d[cnt_op[1]] & 63
+            addr = None
+            v = self.d[dst[1]] & mask_of(sz)
+        bits, m = SIZE_BITS[sz], mask_of(sz)
+        self.cycles += 2 * count + (2 if sz == 'l' else 0)
+        c = 0
+        overflow = 0
+        r = v
+        for _ in range(count):
+            if mnem in ('asl', 'lsl'):
+                c = (r >> (bits - 1)) & 1
+                nr = (r << 1) & m
+                if mnem == 'asl' and (nr ^ r) & msb_of(sz):
+                    overflow = 1
+                r = nr
+            elif mnem == 'asr':
+                c = r & 1
+                r = (r >> 1) | (r & msb_of(sz))
+            elif mnem == 'lsr':
+                c = r & 1
+                r = r >> 1
+            elif mnem == 'rol':
+                c = (r >> (bits - 1)) & 1
+                r = ((r << 1) | c) & m
+            else:
+                c = r & 1
+                r = (r >> 1) | (c << (bits - 1))
+        self.set_nz(r, sz)
+        self.flags['V'] = overflow
+        self.flags['C'] = c if count else 0
+        if count and mnem[:2] != 'ro':
+            self.flags['X'] = c
+        if addr is None:
+            self.set_d(dst[1], sz, r)
+        else:
+            self.write(addr, 'w', r)
+        return nxt
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Harnais de non-régression du moteur de route.
+
+Exécute renderRoadStripsASM et clearPlanA (src/road_engine.s) dans le
+simulateur 68000 (m68k_sim.py) sur des jeux de strips aléatoires et compare
+la VRAM obtenue, mot par mot, au modèle de référence C
+(tools/road_ref/road_ref.c) compilé sur l'hôte.
+
+Usage:
+    python3 tools/road_harness.py [--iterations N] [--seed S]
+"""
+
+import argparse
+import ctypes
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from m68k_sim import Machine, Program, SimError  # noqa: E402
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+REF_DIR = os.path.join(ROOT, 'tools', 'road_ref')
+
+MAX_STRIPS = 120
+STRIP_SIZE = 8
+PLANE_A_BASE = 0xC000
+PLANE_CELLS = 64 * 32
+STRIPS_ADDR = 0xFF0000
+
+
+class RoadRefStrip(ctypes.Structure):
+    _fields_ = [('screenY', ctypes.c_ushort), ('roadWidth', ctypes.c_ushort),
+                ('roadXOffset', ctypes.c_short), ('scale', ctypes.c_ushort)]
+
+
+def build_reference(workdir):
+    """Compile le modèle de référence en bibliothèque partagée"""
+    lib = os.path.join(workdir, 'libroadref.so')
+    subprocess.run(['cc', '-O2', '-shared', '-fPIC', '-I', REF_DIR,
+                    os.path.join(REF_DIR, 'road_ref.c'), '-o', lib], check=True)
+    ref = ctypes.CDLL(lib)
+    ref.roadRefRender.argtypes = [ctypes.POINTER(RoadRefStrip), ctypes.c_ushort,
+                                  ctypes.POINTER(ctypes.c_ushort)]
+    ref.roadRefClearPlanA.argtypes = [ctypes.POINTER(ctypes.c_ushort)]
+    return ref
+
+
+def realistic_strips(rng):
+    """Strips comme les produit generateRoadStrips() (horizon 80, largeur 0-160)"""
+    curve = rng.randint(-40, 40)
+    camera = rng.randint(-200, 200)
+    strips = []
+    for i in range(MAX_STRIPS):
+        y = 80 + i
+        if y >= 224:
+            y = 0
+        scale = (224 - y) * 256 // 144 if y else 0
+        offset = max(-320, min(320, camera + ((curve * (224 - y)) >> 4)))
+        strips.append((y, (160 * scale) >> 8, offset, scale))
+    return strips
+
+
+def random_strips(rng):
+    """Strips arbitraires : hors zone, débordements 16 bits, ordre quelconque"""
+    strips = []
+    for _ in range(rng.randint(0, MAX_STRIPS)):
+        y = rng.choice([rng.randint(70, 230), rng.randint(0, 0xFFFF)])
+        width = rng.choice([rng.randint(0, 400), rng.randint(0, 0xFFFF)])
+        offset = rng.choice([rng.randint(-400, 400), rng.randint(-0x8000, 0x7FFF)])
+        strips.append((y, width, offset, rng.randint(0, 0xFFFF)))
+    return strips
+
+
+def load_strips(machine, strips):
+    for i, (y, width, offset, scale) in enumerate(strips):
+        base = STRIPS_ADDR + i * STRIP_SIZE
+        machine.poke16(base, y)
+        machine.poke16(base + 2, width)
+        machine.poke16(base + 4, offset & 0xFFFF)
+        machine.poke16(base + 6, scale)
+
+
+def compare(machine, expected_plane, label):
+    """Compare toute la VRAM : le plan A attendu, le reste inchangé"""
+    errors = []
+    for cell in range(PLANE_CELLS):
+        got = machine.vdp.vram_word(PLANE_A_BASE + cell * 2)
+        if got != expected_plane[cell]:
+            errors.append('%s: cellule (%d,%d) = 0x%04X, attendu 0x%04X'
+                          % (label, cell % 64, cell // 64, got, expected_plane[cell]))
+    return errors
+
+
+def run(iterations, seed):
+    rng = random.Random(seed)
+    program = Program(os.path.join(ROOT, 'src', 'road_engine.s'), [os.path.join(ROOT, 'inc')])
+
+    with tempfile.TemporaryDirectory() as workdir:
+        ref = build_reference(workdir)
+        failures = 0
+        cycles = []
+
+        for it in range(iterations):
+            strips = realistic_strips(rng) if it % 4 == 0 else random_strips(rng)
+            machine = Machine(program)
+
+            # VRAM initiale aléatoire : toute écriture hors zone est détectée
+            background = bytes(rng.getrandbits(8) for _ in range(0x10000))
+            machine.vdp.vram[:] = background
+            plane = (ctypes.c_ushort * PLANE_CELLS)()
+            for cell in range(PLANE_CELLS):
+                plane[cell] = machine.vdp.vram_word(PLANE_A_BASE + cell * 2)
+
+            load_strips(machine, strips)
+            ref_strips = (RoadRefStrip * max(1, len(strips)))(*[RoadRefStrip(*s) for s in strips])
+
+            try:
+                if it % 16 == 15:
+                    machine.call('clearPlanA')
+                    ref.roadRefClearPlanA(plane)
+                    label = 'clearPlanA #%d' % it
+                else:
+                    machine.call('renderRoadStripsASM', [STRIPS_ADDR, len(strips)])
+                    ref.roadRefRender(ref_strips, len(strips), plane)
+                    label = 'renderRoadStripsASM #%d (%d strips)' % (it, len(strips))
+                    if it % 4 == 0:
+                        cycles.append(machine.cycles)
+            except SimError as e:
+                print('ÉCHEC %d: %s' % (it, e))
+                failures += 1
+                continue
+
+            errors = compare(machine, plane, label)
+            outside = [a for a in range(0x10000)
+                       if not PLANE_A_BASE <= a < PLANE_A_BASE + PLANE_CELLS * 2
+                       and machine.vdp.vram[a] != background[a]]
+            if outside:
+                errors.append('%s: %d octets modifiés hors du plan A (0x%04X...)'
+                              % (label, len(outside), outside[0]))
+            if errors:
+                failures += 1
+                for line in errors[:8]:
+                    print(line)
+
+        print('%d jeux de strips, %d échec(s)' % (iterations, failures))
+        if cycles:
+            print('renderRoadStripsASM (strips réalistes): ~%d cycles estimés par appel'
+                  % (sum(cycles) // len(cycles)))
+        return failures == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('--iterations', type=int, default=2000)
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+    sys.exit(0 if run(args.iterations, args.seed) else 1)
+
+
+if __name__ == '__main__':
+    main()
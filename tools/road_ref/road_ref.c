@@ -0,0 +1,65 @@
+/* road_ref.c - Modèle de référence portable du rendu tilemap de la route */
+
+#include "road_ref.h"
+
+// Décalage arithmétique à droite portable (équivalent de asr.w)
+static short asrWord(short value, int shift) {
+    if (value >= 0) return (short)(value >> shift);
+    return (short)(-((-(int)value + (1 << shift) - 1) >> shift));
+}
+
+int roadRefStripSpan(const RoadRefStrip* strip, short* left, short* right) {
+    // Comparaisons signées 16 bits, comme cmp.w / bge / blt
+    short y = (short)strip->screenY;
+    short half;
+    short center;
+
+    if (y >= ROAD_REF_SCREEN_H || y < ROAD_REF_HORIZON_Y) return 0;
+
+    // roadWidth est le diamètre de la route en pixels (lsr.w #1)
+    half = (short)(strip->roadWidth >> 1);
+    center = (short)(ROAD_REF_CENTER_X + strip->roadXOffset);
+
+    // Bords en pixels (add.w / sub.w avec débordement 16 bits) puis en tuiles de 8px
+    *left = asrWord((short)(center - half), 3);
+    *right = asrWord((short)(center + half), 3);
+
+    // Limitation aux bords de l'écran
+    if (*left < 0) *left = 0;
+    if (*right > ROAD_REF_SCREEN_COLS - 1) *right = ROAD_REF_SCREEN_COLS - 1;
+
+    return 1;
+}
+
+void roadRefRender(const RoadRefStrip* strips, unsigned short numStrips,
+                   unsigned short* plane) {
+    unsigned short i;
+    short x, left, right;
+
+    // Les strips sont appliqués dans l'ordre : le dernier strip d'une ligne
+    // de tuiles (8 scanlines) fixe le contenu de cette ligne
+    for (i = 0; i < numStrips; i++) {
+        unsigned short* row;
+
+        if (!roadRefStripSpan(&strips[i], &left, &right)) continue;
+
+        row = &plane[(strips[i].screenY >> 3) * ROAD_REF_PLANE_WIDTH];
+
+        for (x = 0; x < ROAD_REF_SCREEN_COLS; x++) {
+            row[x] = (x >= left && x <= right) ? ROAD_REF_TILE_ROAD
+                                               : ROAD_REF_TILE_GRASS;
+        }
+    }
+}
+
+void roadRefClearPlanA(unsigned short* plane) {
+    unsigned short y, x;
+
+    for (y = 0; y < ROAD_REF_CLEAR_ROWS; y++) {
+        unsigned short* row = &plane[(ROAD_REF_CLEAR_FIRST_ROW + y) * ROAD_REF_PLANE_WIDTH];
+
+        for (x = 0; x < ROAD_REF_SCREEN_COLS; x++) {
+            row[x] = 0;
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef _ROAD_REF_H_
+#define _ROAD_REF_H_
+
+/*
+ * road_ref.h - Modèle de référence C de renderRoadStripsASM / clearPlanA
+ *
+ * Ce module est la spécification exécutable du générateur de tilemap de la
+ * route. Il est écrit en C ISO sans dépendance SGDK pour être compilé sur
+ * l'hôte et comparé à src/road_engine.s exécuté dans le simulateur 68000
+ * (tools/road_harness.py). Toute réécriture de road_engine.s doit produire
+ * exactement le même contenu de Plan A que roadRefRender().
+ */
+
+// Géométrie du Plan A (64x32 cellules, mots de tilemap)
+#define ROAD_REF_PLANE_WIDTH   64
+#define ROAD_REF_PLANE_HEIGHT  32
+#define ROAD_REF_PLANE_CELLS   (ROAD_REF_PLANE_WIDTH * ROAD_REF_PLANE_HEIGHT)
+
+// Zone visible traitée par le moteur de route
+#define ROAD_REF_SCREEN_COLS   40
+#define ROAD_REF_SCREEN_H      224
+#define ROAD_REF_HORIZON_Y     80
+#define ROAD_REF_CENTER_X      160
+
+// Mots de tilemap écrits : mêmes banques que road_engine.s
+#include "../../inc/vram_layout.h"
+#define ROAD_REF_TILE_ROAD     VRAM_ROAD_TILE
+#define ROAD_REF_TILE_GRASS    VRAM_GRASS_TILE
+
+// Zone effacée par clearPlanA (lignes de tuiles 10 à 27)
+#define ROAD_REF_CLEAR_FIRST_ROW  10
+#define ROAD_REF_CLEAR_ROWS       18
+
+// Même disposition mémoire que RoadStrip (8 octets, big-endian sur la cible)
+typedef struct {
+    unsigned short screenY;
+    unsigned short roadWidth;
+    short roadXOffset;
+    unsigned short scale;
+} RoadRefStrip;
+
+// Applique numStrips strips sur plane (ROAD_REF_PLANE_CELLS mots)
+void roadRefRender(const RoadRefStrip* strips, unsigned short numStrips,
+                   unsigned short* plane);
+
+// Calcule les bornes [left, right] en colonnes de tuiles d'un strip.
+// Retourne 0 si le strip est hors de la zone route (rien n'est écrit).
+int roadRefStripSpan(const RoadRefStrip* strip, short* left, short* right);
+
+// Équivalent de clearPlanA
+void roadRefClearPlanA(unsigned short* plane);
+
+#endif // _ROAD_REF_H_